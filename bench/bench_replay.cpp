@@ -0,0 +1,218 @@
+// Replays key traces through GameController::processInput on a HeadlessUI, with no terminal,
+// and prints a latency histogram for every kind of key. A key that starts a background job
+// (a hint that needs a solve, a new game) is timed until the job's result has been applied,
+// and every event includes rendering the frame that follows it.
+//
+//   bench_replay [TRACE...] [--generate EVENTS] [--seed S] [--save FILE] [--max-p99 US]
+//
+// Without TRACE files a trace of EVENTS keys (default 20000) is made up from seed S: cursor
+// moves, digits, erases and menu actions in roughly a player's proportions. --save writes the
+// trace in HeadlessUI's key script format, so a run can be replayed exactly. With --max-p99 the
+// exit status is 1 when some kind of key is slower than that at the 99th percentile.
+
+#include "GameController.hpp"
+#include "HeadlessUI.hpp"
+#include <ncurses.h>    // key codes only, no terminal is opened
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Kind { Move, Digit, Erase, Focus, Menu, Action, Other, COUNT };
+constexpr std::array<const char*, static_cast<int>(Kind::COUNT)> KIND_NAMES = {
+    "move", "digit", "erase", "focus", "menu", "action", "other"};
+
+constexpr int BUCKETS = 32;             // power-of-two buckets of nanoseconds
+
+struct Histogram {
+    std::vector<std::uint32_t> samples;             // ns, for the percentiles
+    std::array<std::size_t, BUCKETS> buckets{};     // bucket b holds [2^b, 2^(b+1)) ns
+
+    void add(std::uint64_t ns) {
+        samples.push_back(static_cast<std::uint32_t>(std::min<std::uint64_t>(ns, UINT32_MAX)));
+        int bucket = 0;
+        while (bucket + 1 < BUCKETS && (ns >> (bucket + 1)) != 0) ++bucket;
+        ++buckets[bucket];
+    }
+
+    double percentileUs(double fraction) {
+        if (samples.empty()) return 0.0;
+        auto rank = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+        return samples[rank] / 1000.0;
+    }
+};
+
+// the kind of a key, given where the focus was when it was pressed
+Kind classify(int key, FocusState focus) {
+    if (key == '\t') return Kind::Focus;
+    if (focus == FocusState::MENU) {
+        if (key == KEY_UP || key == KEY_DOWN) return Kind::Menu;
+        if (key == '\n' || key == KEY_ENTER) return Kind::Action;
+        return Kind::Other;
+    }
+    if (key == KEY_UP || key == KEY_DOWN || key == KEY_LEFT || key == KEY_RIGHT) return Kind::Move;
+    if (key >= '1' && key <= '9') return Kind::Digit;
+    if (key == '0' || key == KEY_BACKSPACE || key == 127) return Kind::Erase;
+    return Kind::Other;
+}
+
+// A made-up session. Menu actions are spelled out as the keys a player would press: Tab, arrows
+// to the item, Enter, and Tab back unless the action returns focus to the board by itself.
+std::vector<int> generateTrace(std::size_t events, std::uint32_t seed) {
+    static constexpr int MENU_ITEMS = 5;            // Submit, Undo, Hint, New Game, Quit
+    static constexpr int SUBMIT = 0, UNDO = 1, HINT = 2, NEW_GAME = 3;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> digit(1, 9);
+    const std::array<int, 4> arrows = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT};
+
+    std::vector<int> keys;
+    keys.reserve(events + 8);
+    int selected = 0;
+    while (keys.size() < events) {
+        const int roll = percent(rng);
+        if (roll < 60) {
+            keys.push_back(arrows[rng() % arrows.size()]);
+        } else if (roll < 85) {
+            keys.push_back('0' + digit(rng));
+        } else if (roll < 92) {
+            keys.push_back(roll % 2 ? KEY_BACKSPACE : '0');
+        } else {
+            // a menu action; new games are rare, undo is the common one
+            const int pick = percent(rng);
+            const int target = pick < 50 ? UNDO : pick < 80 ? HINT : pick < 95 ? SUBMIT : NEW_GAME;
+            keys.push_back('\t');
+            while (selected != target) {
+                const bool down = (target - selected + MENU_ITEMS) % MENU_ITEMS <= MENU_ITEMS / 2;
+                keys.push_back(down ? KEY_DOWN : KEY_UP);
+                selected = (selected + (down ? 1 : MENU_ITEMS - 1)) % MENU_ITEMS;
+            }
+            keys.push_back('\n');
+            if (target != NEW_GAME) keys.push_back('\t');
+        }
+    }
+    return keys;
+}
+
+bool readTrace(const std::string& path, std::vector<int>& keys) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::ostringstream text;
+    text << in.rdbuf();
+    return HeadlessUI::parseKeys(text.str(), keys);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> traces;
+    std::size_t events = 20000;
+    std::uint32_t seed = 1;
+    std::string save_path;
+    double max_p99_us = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--generate" && i + 1 < argc) {
+            events = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--save" && i + 1 < argc) {
+            save_path = argv[++i];
+        } else if (arg == "--max-p99" && i + 1 < argc) {
+            max_p99_us = std::atof(argv[++i]);
+        } else {
+            traces.emplace_back(arg);
+        }
+    }
+
+    std::vector<int> keys;
+    for (const std::string& path : traces) {
+        if (!readTrace(path, keys)) {
+            std::cerr << "bench_replay: cannot read key trace " << path << "\n";
+            return 2;
+        }
+    }
+    if (traces.empty()) {
+        keys = generateTrace(events, seed);
+    }
+    if (!save_path.empty()) {
+        auto text = HeadlessUI::formatKeys(keys);
+        if (!text) {
+            std::cerr << "bench_replay: the trace has a key code a script cannot hold\n";
+            return 2;
+        }
+        std::ofstream(save_path) << *text << "\n";
+    }
+
+    SudokuBoard board;
+    board.generatePuzzle(SudokuBoard::Difficulty::Easy);
+    auto owned_ui = std::make_unique<HeadlessUI>(board);
+    HeadlessUI& ui = *owned_ui;
+    GameController controller(board, std::move(owned_ui));
+
+    std::array<Histogram, static_cast<int>(Kind::COUNT)> histograms;
+    for (Histogram& histogram : histograms) {
+        histogram.samples.reserve(keys.size());
+    }
+    std::size_t replayed = 0;
+    const auto start = Clock::now();
+    for (int key : keys) {
+        if (!controller.isRunning()) break;         // a solved board or a quit ends the session
+        const Kind kind = classify(key, ui.getFocus());
+        const auto before = Clock::now();
+        controller.processInput(key);
+        controller.waitForTask();
+        ui.displayBoard();
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count();
+        histograms[static_cast<int>(kind)].add(static_cast<std::uint64_t>(ns));
+        ++replayed;
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("replayed %zu of %zu keys in %.3f s: %.0f keys/s, %zu frames, %zu messages\n", replayed, keys.size(),
+                seconds, seconds > 0.0 ? replayed / seconds : 0.0, ui.getCounters().frames, ui.getCounters().messages);
+    std::printf("%-7s %8s %10s %10s %10s %10s\n", "kind", "count", "p50 us", "p90 us", "p99 us", "max us");
+    bool too_slow = false;
+    for (int k = 0; k < static_cast<int>(Kind::COUNT); ++k) {
+        Histogram& histogram = histograms[k];
+        if (histogram.samples.empty()) continue;
+        const double p99 = histogram.percentileUs(0.99);
+        std::printf("%-7s %8zu %10.1f %10.1f %10.1f %10.1f\n", KIND_NAMES[k], histogram.samples.size(),
+                    histogram.percentileUs(0.50), histogram.percentileUs(0.90), p99,
+                    *std::max_element(histogram.samples.begin(), histogram.samples.end()) / 1000.0);
+        too_slow = too_slow || (max_p99_us > 0.0 && p99 > max_p99_us);
+    }
+
+    // one bar per occupied power-of-two bucket, scaled to the kind's largest bucket
+    for (int k = 0; k < static_cast<int>(Kind::COUNT); ++k) {
+        const Histogram& histogram = histograms[k];
+        if (histogram.samples.empty()) continue;
+        std::printf("\n%s\n", KIND_NAMES[k]);
+        const std::size_t peak = *std::max_element(histogram.buckets.begin(), histogram.buckets.end());
+        for (int b = 0; b < BUCKETS; ++b) {
+            if (histogram.buckets[b] == 0) continue;
+            const int width = static_cast<int>(40 * histogram.buckets[b] / peak);
+            std::printf("  %10.2f us %8zu %.*s\n", (1ull << b) / 1000.0, histogram.buckets[b], std::max(width, 1),
+                        "########################################");
+        }
+    }
+    if (too_slow) {
+        std::printf("\np99 above %.1f us\n", max_p99_us);
+        return 1;
+    }
+    return 0;
+}
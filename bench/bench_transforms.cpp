@@ -0,0 +1,85 @@
+// Puzzles per second from SudokuBoard::generatePuzzle (fill a grid, dig with a uniqueness
+// check per clue) against GridTransform images of one generated puzzle.
+//
+//   bench_transforms [GENERATED] [TRANSFORMED]     defaults: 200 and 1000000
+
+#include "GridTransform.hpp"
+#include "SudokuBoard.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_set>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t gridHash(const SudokuBoard::Grid& grid) noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (std::uint8_t value : grid) {
+        hash = (hash ^ value) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int generated = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    const int transformed = argc > 2 ? std::max(1, std::atoi(argv[2])) : 1000000;
+
+    // fill-and-dig, the path the game and the pool use
+    SudokuBoard board;
+    std::uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < generated; ++i) {
+        board.generatePuzzle(SudokuBoard::Difficulty::Medium);
+        checksum += board.getFilledCount();
+    }
+    const double generate_seconds = secondsSince(start);
+
+    // images of the last puzzle and its solution
+    SudokuBoard::Grid puzzle{};
+    std::copy(board.getBoard().begin(), board.getBoard().end(), puzzle.begin());
+    std::mt19937 rng(12345);
+    SudokuBoard solved = board;
+    solved.solveBoard(rng);
+    SudokuBoard::Grid solution{};
+    std::copy(solved.getBoard().begin(), solved.getBoard().end(), solution.begin());
+
+    SudokuBoard::Grid out_puzzle{};
+    SudokuBoard::Grid out_solution{};
+    std::unordered_set<std::uint64_t> distinct;
+    distinct.reserve(static_cast<std::size_t>(transformed));
+    start = Clock::now();
+    for (int i = 0; i < transformed; ++i) {
+        GridTransform transform = GridTransform::random(rng);
+        transform.apply(puzzle, out_puzzle);
+        transform.apply(solution, out_solution);
+        checksum += out_puzzle[i % SudokuBoard::CELLS] + out_solution[0];
+    }
+    const double transform_seconds = secondsSince(start);
+
+    // distinctness is measured separately so hashing does not count against the transforms
+    for (int i = 0; i < transformed; ++i) {
+        GridTransform::random(rng).apply(puzzle, out_puzzle);
+        distinct.insert(gridHash(out_puzzle));
+    }
+
+    const double generate_rate = generated / generate_seconds;
+    const double transform_rate = transformed / transform_seconds;
+    std::printf("fill-and-dig : %8d puzzles in %8.3f s  %12.0f puzzles/s  %10.1f us/puzzle\n",
+                generated, generate_seconds, generate_rate, 1e6 / generate_rate);
+    std::printf("transform    : %8d puzzles in %8.3f s  %12.0f puzzles/s  %10.3f us/puzzle\n",
+                transformed, transform_seconds, transform_rate, 1e6 / transform_rate);
+    std::printf("speedup %.0fx, %zu of %d transformed puzzles distinct (checksum %llu)\n",
+                transform_rate / generate_rate, distinct.size(), transformed,
+                static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,68 @@
+#ifndef ASYNC_JOB_HPP
+#define ASYNC_JOB_HPP
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+// One result computed on a thread of its own, so the caller's loop keeps running meanwhile.
+// start() hands the work a std::stop_token and returns at once; the owner polls isReady()
+// between other work and take()s the result as a future's value. Cancellation is cooperative:
+// cancel() requests a stop, waits for the work to notice and return, and drops whatever it
+// produced, so work must poll its token often enough for that wait to go unnoticed. Work
+// returns std::nullopt when it stops early or has no answer.
+template <typename T>
+class AsyncJob {
+public:
+    AsyncJob() = default;
+    ~AsyncJob() { cancel(); }
+    AsyncJob(const AsyncJob&) = delete;
+    AsyncJob& operator=(const AsyncJob&) = delete;
+
+    // work(std::stop_token) -> std::optional<T>; a job still running is cancelled first.
+    // Throws std::system_error if no thread can be started.
+    template <typename Work>
+    void start(Work work) {
+        cancel();
+        std::promise<std::optional<T>> promise;
+        result_ = promise.get_future();
+        thread_ = std::jthread([work = std::move(work), promise = std::move(promise)](std::stop_token stop) mutable {
+            try {
+                promise.set_value(work(stop));
+            } catch (...) {
+                promise.set_exception(std::current_exception());   // handed to take(), not std::terminate
+            }
+        });
+    }
+
+    bool isRunning() const noexcept { return result_.valid(); }      // started and not yet taken
+    bool isReady() const noexcept {
+        return result_.valid() && result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // Blocks until the work returns, then hands over its result and frees the thread.
+    // Rethrows anything the work threw.
+    std::optional<T> take() {
+        std::optional<T> value = result_.get();
+        thread_.join();
+        return value;
+    }
+
+    void cancel() noexcept {
+        if (thread_.joinable()) {
+            thread_.request_stop();
+            thread_.join();
+        }
+        result_ = {};
+    }
+
+private:
+    std::future<std::optional<T>> result_;
+    std::jthread thread_;
+};
+
+#endif // ASYNC_JOB_HPP
@@ -0,0 +1,234 @@
+#include "BatchSolver.hpp"
+#include "SearchSolver.hpp"
+#include "SudokuGeometry.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SUDOKU_BATCH_X86 1
+#endif
+
+namespace {
+
+constexpr const SudokuGeometry& GEO = GEOMETRY;
+constexpr int CELLS = SudokuGeometry::CELLS;
+constexpr std::uint16_t ALL_DIGITS = (1u << SudokuGeometry::SIZE) - 1;
+using Clock = std::chrono::steady_clock;
+
+std::uint32_t nanosSince(Clock::time_point start) noexcept {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    return static_cast<std::uint32_t>(std::min<long long>(ns, UINT32_MAX));
+}
+
+enum class LaneResult { Contradiction, Lockstep, SearchSolved, SearchFailed };
+
+// Finish one puzzle from its candidate masks: done if every cell is a single, hopeless if
+// any cell is empty, otherwise the singles become givens for the scalar search.
+LaneResult finishLane(const std::array<std::uint16_t, CELLS>& masks, SudokuBoard::Grid& out,
+                      SearchSolver& fallback) noexcept {
+    bool complete = true;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        std::uint16_t mask = masks[cell];
+        if (mask == 0) return LaneResult::Contradiction;
+        if (std::has_single_bit(mask)) {
+            out[cell] = static_cast<std::uint8_t>(std::countr_zero(mask) + 1);
+        } else {
+            out[cell] = 0;
+            complete = false;
+        }
+    }
+    if (complete) return LaneResult::Lockstep;
+    return fallback.solve(out) ? LaneResult::SearchSolved : LaneResult::SearchFailed;
+}
+
+#ifdef SUDOKU_BATCH_X86
+typedef std::uint16_t Lanes8 __attribute__((vector_size(16)));     // one SSE2 register
+typedef std::uint16_t Lanes16 __attribute__((vector_size(32)));    // one AVX2 register
+
+// Naked and hidden single elimination over LANES puzzles at once; cand[cell][lane] is the
+// candidate mask of cell in puzzle lane. Always inlined so each ISA wrapper gets its own copy.
+// Rounds repeat until no lane changes. Masks only ever lose bits, so that takes at most
+// CELLS * SIZE rounds. At the fixed point a cell fixed twice in one unit has been emptied by its
+// peer, so a lane whose cells are all singles is a valid solution and finishLane may trust it.
+template <typename V, int LANES>
+[[gnu::always_inline]] inline void lockstepKernel(V* cand) noexcept {
+    while (true) {
+        V changed = {};
+
+        // naked singles: drop every digit already fixed in one of the cell's peers
+        for (int cell = 0; cell < CELLS; ++cell) {
+            V fixed = {};
+            for (std::uint8_t peer : GEO.peers[cell]) {
+                V m = cand[peer];
+                fixed |= m & (V)((m & (m - 1)) == 0);
+            }
+            V next = cand[cell] & ~fixed;
+            changed |= next ^ cand[cell];
+            cand[cell] = next;
+        }
+
+        // hidden singles: a digit with one place left in a unit claims that cell
+        for (int unit = 0; unit < SudokuGeometry::UNITS; ++unit) {
+            V once = {};
+            V twice = {};
+            for (std::uint8_t cell : GEO.unit_cells[unit]) {
+                V m = cand[cell];
+                twice |= once & m;
+                once |= m;
+            }
+            V lone = once & ~twice;
+            for (std::uint8_t cell : GEO.unit_cells[unit]) {
+                V m = cand[cell];
+                V hit = m & lone;
+                V take = (V)(hit != 0) & (V)((m & (m - 1)) != 0);
+                V next = (hit & take) | (m & ~take);
+                changed |= next ^ m;
+                cand[cell] = next;
+            }
+        }
+
+        bool any = false;
+        for (int lane = 0; lane < LANES; ++lane) {
+            any |= changed[lane] != 0;
+        }
+        if (!any) break;
+    }
+}
+
+__attribute__((target("avx2"))) void runKernelAvx2(Lanes16* cand) noexcept {
+    lockstepKernel<Lanes16, 16>(cand);
+}
+
+__attribute__((target("sse2"))) void runKernelSse2(Lanes8* cand) noexcept {
+    lockstepKernel<Lanes8, 8>(cand);
+}
+
+// Pack up to LANES puzzles starting at first, run the kernel and unpack every lane.
+template <typename V, int LANES, void (*Kernel)(V*)>
+void solvePack(std::span<const SudokuBoard::Grid> puzzles, std::size_t first,
+               std::span<SudokuBoard::Grid> solutions, std::span<std::uint8_t> solved,
+               std::span<std::uint32_t> latency_ns, SearchSolver& fallback,
+               BatchSolver::BatchStats& stats) noexcept {
+    const bool timed = !latency_ns.empty();
+    const auto pack_start = timed ? Clock::now() : Clock::time_point{};
+    const std::size_t count = std::min<std::size_t>(LANES, puzzles.size() - first);
+    alignas(32) V cand[CELLS];
+    for (int cell = 0; cell < CELLS; ++cell) {
+        for (int lane = 0; lane < LANES; ++lane) {
+            std::uint16_t mask = ALL_DIGITS;    // padding lanes stay fully open
+            if (static_cast<std::size_t>(lane) < count) {
+                int value = puzzles[first + lane][cell];
+                mask = value == 0 ? ALL_DIGITS
+                     : value <= SudokuGeometry::SIZE ? static_cast<std::uint16_t>(1u << (value - 1))
+                     : 0;               // out-of-range digit: lane is unsolvable
+            }
+            cand[cell][lane] = mask;
+        }
+    }
+
+    Kernel(cand);
+    // every lane rides the whole lockstep pass, then pays for its own finish on top
+    const std::uint32_t shared_ns = timed ? nanosSince(pack_start) : 0;
+
+    std::array<std::uint16_t, CELLS> masks{};
+    for (std::size_t lane = 0; lane < count; ++lane) {
+        for (int cell = 0; cell < CELLS; ++cell) {
+            masks[cell] = cand[cell][lane];
+        }
+        SudokuBoard::Grid& out = solutions[first + lane];
+        const auto lane_start = timed ? Clock::now() : Clock::time_point{};
+        LaneResult result = finishLane(masks, out, fallback);
+        if (timed) {
+            latency_ns[first + lane] = static_cast<std::uint32_t>(
+                std::min<std::uint64_t>(std::uint64_t{shared_ns} + nanosSince(lane_start), UINT32_MAX));
+        }
+        bool ok = result == LaneResult::Lockstep || result == LaneResult::SearchSolved;
+        if (!ok) {
+            out = puzzles[first + lane];
+        }
+        solved[first + lane] = ok;
+        stats.solved += ok;
+        stats.lockstep_solved += result == LaneResult::Lockstep;
+        stats.scalar_fallbacks += result == LaneResult::SearchSolved || result == LaneResult::SearchFailed;
+    }
+}
+#endif // SUDOKU_BATCH_X86
+
+} // namespace
+
+BatchSolver::BatchSolver(Isa isa) : isa_(isSupported(isa) ? isa : Isa::Scalar) {}
+
+BatchSolver::Isa BatchSolver::detectIsa() noexcept {
+    if (isSupported(Isa::Avx2)) return Isa::Avx2;
+    if (isSupported(Isa::Sse2)) return Isa::Sse2;
+    return Isa::Scalar;
+}
+
+bool BatchSolver::isSupported(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::Scalar: return true;
+#ifdef SUDOKU_BATCH_X86
+        case Isa::Sse2: return __builtin_cpu_supports("sse2");
+        case Isa::Avx2: return __builtin_cpu_supports("avx2");
+#else
+        case Isa::Sse2:
+        case Isa::Avx2: return false;
+#endif
+    }
+    return false;
+}
+
+const char* BatchSolver::isaName(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::Sse2: return "sse2";
+        case Isa::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+int BatchSolver::laneCount() const noexcept {
+    switch (isa_) {
+        case Isa::Scalar: return 1;
+        case Isa::Sse2: return 8;
+        case Isa::Avx2: return 16;
+    }
+    return 1;
+}
+
+std::size_t BatchSolver::solve(std::span<const Grid> puzzles, std::span<Grid> solutions,
+                               std::span<std::uint8_t> solved, std::span<std::uint32_t> latency_ns) noexcept {
+    stats_ = {};
+    const std::size_t count = std::min({puzzles.size(), solutions.size(), solved.size()});
+    puzzles = puzzles.first(count);
+    if (!latency_ns.empty()) latency_ns = latency_ns.first(std::min(count, latency_ns.size()));
+    if (latency_ns.size() < count) latency_ns = {};     // partial timing is no timing
+    stats_.puzzles = count;
+
+    const std::size_t lanes = static_cast<std::size_t>(laneCount());
+    for (std::size_t first = 0; first < count; first += lanes) {
+        switch (isa_) {
+#ifdef SUDOKU_BATCH_X86
+            case Isa::Avx2:
+                solvePack<Lanes16, 16, runKernelAvx2>(puzzles, first, solutions, solved, latency_ns, fallback_, stats_);
+                break;
+            case Isa::Sse2:
+                solvePack<Lanes8, 8, runKernelSse2>(puzzles, first, solutions, solved, latency_ns, fallback_, stats_);
+                break;
+#endif
+            default: {
+                // scalar path: plain per-puzzle search
+                const auto start = latency_ns.empty() ? Clock::time_point{} : Clock::now();
+                solutions[first] = puzzles[first];
+                bool ok = fallback_.solve(solutions[first]);
+                if (!latency_ns.empty()) latency_ns[first] = nanosSince(start);
+                solved[first] = ok;
+                stats_.solved += ok;
+                ++stats_.scalar_fallbacks;
+                break;
+            }
+        }
+    }
+    return stats_.solved;
+}
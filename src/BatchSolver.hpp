@@ -0,0 +1,53 @@
+#ifndef BATCH_SOLVER_HPP
+#define BATCH_SOLVER_HPP
+
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Solves many puzzles at once. Puzzles are packed into SIMD lanes (16 per AVX2
+// register, 8 per SSE2 register) and run through naked/hidden single elimination
+// in lockstep; lanes that are not finished when the batch reaches its fixed point
+// fall back to the scalar SearchSolver. The instruction set is chosen at runtime.
+class BatchSolver {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    enum class Isa { Scalar, Sse2, Avx2 };
+
+    // per-run counters, useful to see how much work the vector kernel absorbed
+    struct BatchStats {
+        std::size_t puzzles = 0;
+        std::size_t solved = 0;
+        std::size_t lockstep_solved = 0;     // finished by the SIMD kernel alone
+        std::size_t scalar_fallbacks = 0;    // lanes handed to SearchSolver
+    };
+
+    explicit BatchSolver(Isa isa = detectIsa());
+
+    static Isa detectIsa() noexcept;                    // widest instruction set this CPU supports
+    static bool isSupported(Isa isa) noexcept;
+    static const char* isaName(Isa isa) noexcept;
+
+    Isa getIsa() const noexcept { return isa_; }
+    int laneCount() const noexcept;
+
+    // Solve puzzles[i] into solutions[i]; solved[i] is set to 1 on success, 0 if the puzzle
+    // has no solution (its solutions entry is then a copy of the puzzle). All spans must have
+    // the same length. Returns the number of puzzles solved. If latency_ns is not empty it gets
+    // each puzzle's own solve time: the lockstep pass its lane rode in plus its own finish or
+    // fallback search.
+    std::size_t solve(std::span<const Grid> puzzles, std::span<Grid> solutions,
+                      std::span<std::uint8_t> solved, std::span<std::uint32_t> latency_ns = {}) noexcept;
+
+    const BatchStats& getStats() const noexcept { return stats_; }
+
+private:
+    Isa isa_;
+    BatchStats stats_{};
+    SearchSolver fallback_;                 // finishes the lanes the kernel leaves, reused across calls
+};
+
+#endif // BATCH_SOLVER_HPP
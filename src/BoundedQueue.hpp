@@ -0,0 +1,94 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+// Fixed-capacity multi-producer multi-consumer queue without locks. Every slot carries a
+// sequence number that tells producers and consumers whose turn it is, so a push or pop is
+// one compare-exchange on the shared position plus a store to the slot (Vyukov's bounded
+// MPMC design). tryPush fails when the queue is full and tryPop when it is empty; callers
+// decide whether to spin, yield or give up. T is copied by value and should be small and
+// trivially copyable.
+template <typename T>
+class BoundedQueue {
+public:
+    static_assert(std::is_trivially_copyable_v<T>, "queue slots are plain copies");
+
+    explicit BoundedQueue(std::size_t capacity)
+        : capacity_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<Slot[]>(capacity_)) {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool tryPush(const T& value) noexcept {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;       // the slot still holds an item from one lap ago
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) noexcept {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = slot.value;
+                    slot.sequence.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;       // nothing published at this position yet
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // items pushed and not yet popped; a snapshot that may be stale by the time it returns
+    std::size_t size() const noexcept {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    const std::size_t capacity_;            // power of two
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<std::size_t> tail_{0};      // next push position
+    alignas(64) std::atomic<std::size_t> head_{0};      // next pop position
+};
+
+#endif // BOUNDED_QUEUE_HPP
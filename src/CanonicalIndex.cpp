@@ -0,0 +1,56 @@
+#include "CanonicalIndex.hpp"
+#include <algorithm>
+#include <bit>
+
+CanonicalIndex::CanonicalIndex(std::size_t expected)
+    : slots_(std::bit_ceil(std::max<std::size_t>(expected * 2, 16)), EMPTY),
+      mask_(slots_.size() - 1) {}
+
+std::uint64_t CanonicalIndex::fingerprint(const Grid& grid) noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (std::uint8_t value : grid) {
+        hash = (hash ^ value) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::size_t CanonicalIndex::slotFor(std::uint64_t key) const noexcept {
+    // FNV's low bits are weak on their own; fold the high half in before masking
+    std::size_t slot = static_cast<std::size_t>(key ^ (key >> 32)) & mask_;
+    while (slots_[slot] != EMPTY && slots_[slot] != key) {
+        slot = (slot + 1) & mask_;
+    }
+    return slot;
+}
+
+bool CanonicalIndex::insert(std::uint64_t fingerprint) {
+    const std::uint64_t key = stored(fingerprint);
+    std::size_t slot = slotFor(key);
+    if (slots_[slot] == key) return false;
+    if ((size_ + 1) * 2 > slots_.size()) {
+        grow();
+        slot = slotFor(key);
+    }
+    slots_[slot] = key;
+    ++size_;
+    return true;
+}
+
+bool CanonicalIndex::contains(std::uint64_t fingerprint) const noexcept {
+    const std::uint64_t key = stored(fingerprint);
+    return slots_[slotFor(key)] == key;
+}
+
+void CanonicalIndex::clear() noexcept {
+    std::fill(slots_.begin(), slots_.end(), EMPTY);
+    size_ = 0;
+}
+
+void CanonicalIndex::grow() {
+    std::vector<std::uint64_t> old(slots_.size() * 2, EMPTY);
+    old.swap(slots_);
+    mask_ = slots_.size() - 1;
+    for (std::uint64_t key : old) {
+        if (key != EMPTY) slots_[slotFor(key)] = key;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef CANONICAL_INDEX_HPP
+#define CANONICAL_INDEX_HPP
+
+#include "SudokuBoard.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Set of 64-bit puzzle fingerprints for one-pass deduplication. The table is open addressing
+// with linear probing over a flat array, so a lookup is usually one cache line and memory is
+// 8 bytes per slot; it doubles at half load. Fingerprints are FNV-1a over the 81 digits, so
+// callers that want duplicates up to symmetry hash the Canonicalizer's minlex form. Two
+// different puzzles share a fingerprint with probability about n^2 / 2^65 (around 3e-4 at
+// 100 million puzzles), in which case the later one is reported as a duplicate.
+class CanonicalIndex {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    explicit CanonicalIndex(std::size_t expected = 1024);
+
+    static std::uint64_t fingerprint(const Grid& grid) noexcept;
+
+    bool insert(std::uint64_t fingerprint);                     // true if it was not present yet
+    bool contains(std::uint64_t fingerprint) const noexcept;
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return slots_.size(); }
+    void clear() noexcept;
+
+private:
+    static constexpr std::uint64_t EMPTY = 0;                   // stored fingerprints are never 0
+
+    static std::uint64_t stored(std::uint64_t fingerprint) noexcept { return fingerprint == EMPTY ? 1 : fingerprint; }
+    std::size_t slotFor(std::uint64_t key) const noexcept;      // the key's slot or the empty one ending its probe
+    void grow();
+
+    std::vector<std::uint64_t> slots_;      // power-of-two size
+    std::size_t mask_ = 0;
+    std::size_t size_ = 0;
+};
+
+#endif // CANONICAL_INDEX_HPP
@@ -0,0 +1,216 @@
+#include "Canonicalizer.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr std::uint8_t FRESH = 15;      // sort key of a digit not labeled yet; above every label
+
+constexpr std::array<std::array<std::uint8_t, 3>, 6> PERMUTATIONS_3 = {{
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0},
+}};
+
+constexpr int factorial(int n) noexcept { return n <= 1 ? 1 : n * factorial(n - 1); }
+
+// permutation `index` of the `length` (<= 3) entries starting at `first`
+template <typename T>
+void permuteRange(T* items, int first, int length, int index) noexcept {
+    if (length == 2) {
+        if (index != 0) std::swap(items[first], items[first + 1]);
+    } else if (length == 3) {
+        const T original[3] = {items[first], items[first + 1], items[first + 2]};
+        for (int i = 0; i < 3; ++i) items[first + i] = original[PERMUTATIONS_3[index][i]];
+    }
+}
+
+} // namespace
+
+Canonicalizer::Grid Canonicalizer::canonicalize(const Grid& in) noexcept {
+    Grid out;
+    canonicalize(in, out);
+    return out;
+}
+
+void Canonicalizer::canonicalize(const Grid& in, Grid& out) noexcept {
+    grids_[0] = in;
+    for (int row = 0; row < SIZE; ++row) {
+        for (int col = 0; col < SIZE; ++col) {
+            grids_[1][col * SIZE + row] = in[row * SIZE + col];
+        }
+    }
+
+    // nothing placed yet: the columns of each stack, and the stacks, are all interchangeable
+    current_.clear();
+    for (std::uint8_t g = 0; g < 2; ++g) {
+        State state{};
+        for (int col = 0; col < SIZE; ++col) state.cols[col] = static_cast<std::uint8_t>(col);
+        state.next_label = 1;
+        state.grid = g;
+        state.stack_ties = 0b110;
+        state.col_ties = 0b110110110;
+        current_.push_back(state);
+    }
+    peak_states_ = current_.size();
+    for (int row = 0; row < SIZE; ++row) {
+        extendRow(row);
+    }
+    out = best_;
+}
+
+void Canonicalizer::extendRow(int row) noexcept {
+    std::uint8_t* best_row = &best_[row * SIZE];
+    bool have_best = false;
+    next_.clear();
+    for (const State& state : current_) {
+        // a band's first row may come from any unused band, the others from the band in progress
+        std::uint16_t candidates = 0;
+        if (row % BOX == 0) {
+            for (int band = 0; band < BOX; ++band) {
+                std::uint16_t band_rows = static_cast<std::uint16_t>(((1u << BOX) - 1) << (band * BOX));
+                if ((state.used_rows & band_rows) == 0) candidates |= band_rows;
+            }
+        } else {
+            int band = state.last_row / BOX;
+            candidates = static_cast<std::uint16_t>((((1u << BOX) - 1) << (band * BOX)) & ~state.used_rows);
+        }
+        for (int source = 0; source < SIZE; ++source) {
+            if (candidates & (1u << source)) expand(state, source, best_row, have_best);
+        }
+    }
+    current_.swap(next_);
+    peak_states_ = std::max(peak_states_, current_.size());
+}
+
+void Canonicalizer::expand(const State& state, int source, std::uint8_t* best_row, bool& have_best) noexcept {
+    const std::uint8_t* cells = &grids_[state.grid][source * SIZE];
+
+    // Refine each stack on its own: sort every run of interchangeable columns by key. Blanks
+    // stay interchangeable; labeled digits are distinct. Fresh digits sort last and are
+    // distinct too, but their order is a real choice because it decides their labels.
+    struct Slot {
+        std::array<std::uint8_t, BOX> cols;
+        std::uint8_t ties;              // bit j: column j is interchangeable with j - 1
+        std::uint8_t fresh_first;       // run of >= 2 fresh columns to branch over
+        std::uint8_t fresh_length;
+        std::uint16_t key;              // the stack's sorted keys, packed for comparison
+    };
+    std::array<Slot, BOX> slots;
+    for (int s = 0; s < BOX; ++s) {
+        Slot& slot = slots[s];
+        std::array<std::uint8_t, BOX> keys;
+        for (int j = 0; j < BOX; ++j) {
+            std::uint8_t col = state.cols[s * BOX + j];
+            std::uint8_t value = cells[col];
+            slot.cols[j] = col;
+            keys[j] = value == 0 ? 0 : (state.labels[value] != 0 ? state.labels[value] : FRESH);
+        }
+        std::uint16_t old_ties = static_cast<std::uint16_t>((state.col_ties >> (s * BOX)) & 0b110);
+        // insertion sort that never moves a column across a run boundary
+        for (int j = 1; j < BOX; ++j) {
+            for (int k = j; k > 0 && (old_ties & (1u << k)) && keys[k] < keys[k - 1]; --k) {
+                std::swap(keys[k], keys[k - 1]);
+                std::swap(slot.cols[k], slot.cols[k - 1]);
+            }
+        }
+        slot.ties = 0;
+        slot.fresh_first = 0;
+        slot.fresh_length = 0;
+        for (int j = 1; j < BOX; ++j) {
+            if (!(old_ties & (1u << j)) || keys[j] != keys[j - 1]) continue;
+            if (keys[j] == 0) {
+                slot.ties = static_cast<std::uint8_t>(slot.ties | (1u << j));
+            } else {
+                if (slot.fresh_length == 0) {
+                    slot.fresh_first = static_cast<std::uint8_t>(j - 1);
+                    slot.fresh_length = 1;
+                }
+                ++slot.fresh_length;
+            }
+        }
+        slot.key = static_cast<std::uint16_t>(keys[0] << 8 | keys[1] << 4 | keys[2]);
+    }
+
+    // Then order the stacks inside each run of interchangeable stacks by their keys. Equal
+    // stacks stay interchangeable unless they reveal fresh digits, which again means a branch.
+    std::array<std::uint8_t, BOX> run{};
+    for (int s = 1; s < BOX; ++s) {
+        run[s] = static_cast<std::uint8_t>(run[s - 1] + ((state.stack_ties & (1u << s)) ? 0 : 1));
+    }
+    std::array<std::uint8_t, BOX> order = {0, 1, 2};
+    for (int i = 1; i < BOX; ++i) {
+        for (int k = i; k > 0 && run[order[k]] == run[order[k - 1]] && slots[order[k]].key < slots[order[k - 1]].key; --k) {
+            std::swap(order[k], order[k - 1]);
+        }
+    }
+    std::uint8_t stack_ties = 0;
+    int block_first = 0;
+    int block_length = 0;
+    for (int i = 1; i < BOX; ++i) {
+        const Slot& slot = slots[order[i]];
+        if (run[order[i]] != run[order[i - 1]] || slot.key != slots[order[i - 1]].key) continue;
+        bool fresh = (slot.key & 0xF) == FRESH;     // keys are sorted, so any fresh digit is last
+        if (!fresh) {
+            stack_ties = static_cast<std::uint8_t>(stack_ties | (1u << i));
+        } else {
+            if (block_length == 0) {
+                block_first = i - 1;
+                block_length = 1;
+            }
+            ++block_length;
+        }
+    }
+
+    // Every branch yields the same row; only the labels of its fresh digits differ.
+    std::array<std::uint8_t, SIZE> values;
+    std::uint8_t next_label = state.next_label;
+    for (int i = 0; i < BOX; ++i) {
+        std::uint16_t key = slots[order[i]].key;
+        for (int j = 0; j < BOX; ++j) {
+            std::uint8_t k = static_cast<std::uint8_t>((key >> (4 * (BOX - 1 - j))) & 0xF);
+            values[i * BOX + j] = k == FRESH ? next_label++ : k;
+        }
+    }
+    if (have_best) {
+        auto [value, best] = std::mismatch(values.begin(), values.end(), best_row);
+        if (value != values.end() && *value > *best) return;
+        if (value != values.end()) next_.clear();
+    }
+    std::copy(values.begin(), values.end(), best_row);
+    have_best = true;
+
+    State child = state;
+    child.last_row = static_cast<std::uint8_t>(source);
+    child.used_rows = static_cast<std::uint16_t>(state.used_rows | (1u << source));
+    child.stack_ties = stack_ties;
+    child.col_ties = 0;
+    for (int i = 0; i < BOX; ++i) {
+        child.col_ties = static_cast<std::uint16_t>(child.col_ties | (slots[order[i]].ties << (i * BOX)));
+    }
+
+    for (int stack_branch = 0; stack_branch < factorial(block_length); ++stack_branch) {
+        std::array<std::uint8_t, BOX> branch_order = order;
+        permuteRange(branch_order.data(), block_first, block_length, stack_branch);
+        std::array<int, BOX> branches;
+        for (int i = 0; i < BOX; ++i) branches[i] = factorial(slots[branch_order[i]].fresh_length);
+
+        for (int a = 0; a < branches[0]; ++a) {
+            for (int b = 0; b < branches[1]; ++b) {
+                for (int c = 0; c < branches[2]; ++c) {
+                    const std::array<int, BOX> picks = {a, b, c};
+                    for (int i = 0; i < BOX; ++i) {
+                        const Slot& slot = slots[branch_order[i]];
+                        std::uint8_t* cols = &child.cols[i * BOX];
+                        std::copy(slot.cols.begin(), slot.cols.end(), cols);
+                        permuteRange(cols, slot.fresh_first, slot.fresh_length, picks[i]);
+                    }
+                    child.labels = state.labels;
+                    child.next_label = state.next_label;
+                    for (int col = 0; col < SIZE; ++col) {
+                        std::uint8_t value = cells[child.cols[col]];
+                        if (value != 0 && child.labels[value] == 0) child.labels[value] = child.next_label++;
+                    }
+                    next_.push_back(child);
+                }
+            }
+        }
+    }
+}
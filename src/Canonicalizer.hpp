@@ -0,0 +1,55 @@
+#ifndef CANONICALIZER_HPP
+#define CANONICALIZER_HPP
+
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Minimum-lexicographic (minlex) form of a 9x9 puzzle under the Sudoku symmetry group
+// (transposition, band/row and stack/column permutations, digit relabeling), blanks as 0.
+// Two puzzles are equivalent exactly when their minlex forms are equal.
+//
+// The output is fixed one row at a time, keeping only the partial transforms whose rows so
+// far tie for the minimum. Columns are not enumerated up front: each partial transform keeps
+// groups of columns (and of stacks) that every row so far has left interchangeable, and the
+// next row refines those groups by sorting. Only columns that reveal new digits have to be
+// branched on, because their order decides the relabeling. Digits are relabeled in order of
+// first appearance, the minimal labeling for a fixed arrangement. Buffers are reused between
+// calls, so keep one Canonicalizer per thread.
+class Canonicalizer {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    void canonicalize(const Grid& in, Grid& out) noexcept;
+    Grid canonicalize(const Grid& in) noexcept;
+
+    std::size_t getPeakStates() const noexcept { return peak_states_; }    // widest tie set of the last call
+
+private:
+    static constexpr int SIZE = SudokuBoard::SIZE;
+    static constexpr int BOX = SudokuBoard::BOX_ROWS;
+
+    // a partial transform whose output rows so far tie for the minimum
+    struct State {
+        std::array<std::uint8_t, SIZE> cols;        // source column at each output column
+        std::array<std::uint8_t, SIZE + 1> labels;  // source digit -> output digit, 0 while unlabeled
+        std::uint8_t next_label;
+        std::uint8_t grid;                          // 0: as given, 1: transposed
+        std::uint8_t last_row;                      // source row of the latest output row
+        std::uint8_t stack_ties;                    // bit s: stack slot s is interchangeable with slot s - 1
+        std::uint16_t col_ties;                     // bit p: output column p is interchangeable with p - 1
+        std::uint16_t used_rows;                    // bit per source row already placed
+    };
+
+    void extendRow(int row) noexcept;                                   // states for output row `row`
+    void expand(const State& state, int source, std::uint8_t* best_row, bool& have_best) noexcept;
+
+    std::array<Grid, 2> grids_{};                   // input and its transpose
+    Grid best_{};                                   // minimal prefix found so far
+    std::vector<State> current_;
+    std::vector<State> next_;
+    std::size_t peak_states_ = 0;
+};
+
+#endif // CANONICALIZER_HPP
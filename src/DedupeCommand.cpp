@@ -0,0 +1,152 @@
+#include "DedupeCommand.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void appendRecord(std::string& out, const SudokuBoard::Grid& grid, PuzzleCorpus::Format format) {
+    if (format != PuzzleCorpus::Format::Text) {
+        std::uint8_t record[PuzzleCorpus::PACKED_RECORD_SIZE];
+        PuzzleCorpus::pack(grid, record);
+        out.append(reinterpret_cast<const char*>(record), sizeof(record));
+        return;
+    }
+    for (std::uint8_t value : grid) {
+        out.push_back(value == 0 ? '.' : static_cast<char>('0' + value));
+    }
+    out.push_back('\n');
+}
+
+} // namespace
+
+DedupeCommand::DedupeCommand(Options options) noexcept : options_(std::move(options)) {}
+
+void DedupeCommand::begin() noexcept {
+    report_ = {};
+    index_.clear();
+    output_.clear();
+    header_written_ = false;
+    start_ = Clock::now();
+}
+
+std::optional<DedupeCommand::Report> DedupeCommand::run(std::istream& in, std::ostream& out) {
+    begin();
+    bool supported = true;
+    // a block plus the partial record carried over
+    const bool readable = PuzzleCorpus::readBlocks(in, 2 * BLOCK_BYTES,
+                                                   [&](std::span<const char> region, PuzzleCorpus::Format format) {
+        supported = supported && format != PuzzleCorpus::Format::PackedSolved;
+        if (supported) processRegion(region, format, out);
+    });
+    if (!readable || !supported) return std::nullopt;
+    return finish(out);
+}
+
+std::optional<DedupeCommand::Report> DedupeCommand::runFile(const std::string& path, std::ostream& out) {
+    PuzzleCorpus corpus;
+    if (!corpus.open(path) || corpus.getFormat() == PuzzleCorpus::Format::PackedSolved) return std::nullopt;
+    begin();
+    processRegion(corpus.records(), corpus.getFormat(), out);
+    return finish(out);
+}
+
+void DedupeCommand::processRegion(std::span<const char> data, PuzzleCorpus::Format format, std::ostream& out) {
+    if (format != PuzzleCorpus::Format::Text && !header_written_) {
+        PuzzleCorpus::writePackedHeader(out);
+        header_written_ = true;
+    }
+    Grid canonical{};
+    PuzzleCorpus::forEachRecord(data, format, [&](const Grid& grid, bool ok, std::string_view raw) {
+        ++report_.puzzles;
+        if (!ok) {
+            ++report_.invalid;
+            return;
+        }
+        const Grid* key = &grid;
+        if (!options_.exact || options_.canonical) {
+            canonicalizer_.canonicalize(grid, canonical);
+            report_.peak_states = std::max(report_.peak_states, canonicalizer_.getPeakStates());
+            if (!options_.exact) key = &canonical;
+        }
+        if (!index_.insert(CanonicalIndex::fingerprint(*key))) {
+            ++report_.duplicates;
+            return;
+        }
+        ++report_.unique;
+        if (options_.canonical) {
+            appendRecord(output_, canonical, format);
+        } else if (format == PuzzleCorpus::Format::Text) {
+            output_.append(raw);
+            output_.push_back('\n');
+        } else {
+            appendRecord(output_, grid, format);
+        }
+        if (output_.size() >= BLOCK_BYTES) {
+            out.write(output_.data(), static_cast<std::streamsize>(output_.size()));
+            output_.clear();
+        }
+    });
+}
+
+DedupeCommand::Report DedupeCommand::finish(std::ostream& out) {
+    out.write(output_.data(), static_cast<std::streamsize>(output_.size()));
+    output_.clear();
+    out.flush();
+    report_.seconds = std::chrono::duration<double>(Clock::now() - start_).count();
+    return report_;
+}
+
+void DedupeCommand::printReport(const Report& report, std::ostream& out) {
+    const double rate = report.seconds > 0.0 ? static_cast<double>(report.puzzles) / report.seconds : 0.0;
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "read %zu puzzles: %zu unique, %zu duplicates, %zu invalid in %.3f s: %.0f puzzles/s "
+                  "(peak tie set %zu)\n",
+                  report.puzzles, report.unique, report.duplicates, report.invalid, report.seconds, rate,
+                  report.peak_states);
+    out << buffer;
+}
+
+int DedupeCommand::main(int argc, char** argv) {
+    Options options;
+    std::string output = "-";
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--canonical") {
+            options.canonical = true;
+        } else if (arg == "--exact") {
+            options.exact = true;
+        } else if (arg == "-h" || arg == "--help") {
+            std::cout << "usage: sudoku dedupe [FILE|-] [-o OUT] [--canonical] [--exact]\n";
+            return 0;
+        } else {
+            options.input = arg;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    std::ofstream file;
+    if (output != "-") file.open(output, std::ios::binary);
+    std::ostream& out = output == "-" ? std::cout : file;
+    if (!out) {
+        std::cerr << "sudoku dedupe: cannot write " << output << "\n";
+        return 1;
+    }
+
+    DedupeCommand dedupe(options);
+    auto report = options.input == "-" ? dedupe.run(std::cin, out) : dedupe.runFile(options.input, out);
+    if (!report) {
+        std::cerr << "sudoku dedupe: cannot read " << (options.input == "-" ? "stdin" : options.input)
+                  << " (not a text or packed puzzle file, or an archive with solutions)\n";
+        return 1;
+    }
+    printReport(*report, std::cerr);
+    return out ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+#ifndef DEDUPE_COMMAND_HPP
+#define DEDUPE_COMMAND_HPP
+
+#include "CanonicalIndex.hpp"
+#include "Canonicalizer.hpp"
+#include "PuzzleCorpus.hpp"
+#include "SudokuBoard.hpp"
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+
+// `sudoku dedupe`: one streaming pass over a puzzle library that keeps the first puzzle of
+// every symmetry class. Each record is reduced to its minlex form by the Canonicalizer and
+// looked up by fingerprint in a CanonicalIndex, so memory grows with the number of distinct
+// puzzles, not with the input. Input is text or packed, as for `sudoku solve`: files are
+// memory-mapped, stdin is read in blocks. Kept puzzles are written in the input's format,
+// as they were given or (with --canonical) in minlex form; malformed records are dropped.
+// Archive input is written as a plain packed file, so an archive holding solutions is
+// refused rather than stripped of them.
+class DedupeCommand {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    static constexpr std::size_t BLOCK_BYTES = 4u << 20;    // stdin read size and output flush size
+
+    struct Options {
+        std::string input = "-";            // file path, "-" for stdin
+        bool exact = false;                 // only identical puzzles count as duplicates
+        bool canonical = false;             // write the minlex form instead of the original
+    };
+
+    struct Report {
+        std::size_t puzzles = 0;            // well-formed and malformed records read
+        std::size_t unique = 0;             // puzzles written
+        std::size_t duplicates = 0;
+        std::size_t invalid = 0;
+        std::size_t peak_states = 0;        // widest Canonicalizer tie set over the run
+        double seconds = 0.0;
+    };
+
+    explicit DedupeCommand(Options options) noexcept;
+
+    // nullopt for input that cannot be read or is an archive with solutions
+    std::optional<Report> run(std::istream& in, std::ostream& out);            // streamed input
+    std::optional<Report> runFile(const std::string& path, std::ostream& out);   // mapped input
+
+    static void printReport(const Report& report, std::ostream& out);
+
+    // Entry point for `sudoku dedupe [FILE|-] [-o OUT] [--canonical] [--exact]`; args start at the mode name.
+    static int main(int argc, char** argv);
+
+private:
+    void begin() noexcept;
+    void processRegion(std::span<const char> data, PuzzleCorpus::Format format, std::ostream& out);
+    Report finish(std::ostream& out);
+
+    Options options_;
+    Canonicalizer canonicalizer_;
+    CanonicalIndex index_;
+    std::string output_;                    // kept records waiting for the next flush
+    bool header_written_ = false;
+    Report report_;
+    std::chrono::steady_clock::time_point start_{};
+};
+
+#endif // DEDUPE_COMMAND_HPP
@@ -0,0 +1,188 @@
+#include "DlxSolver.hpp"
+#include <algorithm>
+
+DlxSolver::DlxSolver() noexcept {
+    // root and column headers form the horizontal header list, each header is its own vertical list
+    for (int col = 0; col <= COLUMNS; ++col) {
+        left_[col] = static_cast<std::int16_t>(col == 0 ? COLUMNS : col - 1);
+        right_[col] = static_cast<std::int16_t>(col == COLUMNS ? 0 : col + 1);
+        up_[col] = down_[col] = column_[col] = static_cast<std::int16_t>(col);
+        row_[col] = -1;
+    }
+
+    int next = COLUMNS + 1;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        int row = cell / SIZE;
+        int col = cell % SIZE;
+        int box = (row / 3) * 3 + col / 3;
+        for (int d = 0; d < SIZE; ++d) {
+            const int candidate = cell * SIZE + d;
+            const int columns[4] = {
+                1 + cell,                           // cell is filled
+                1 + CELLS + row * SIZE + d,         // row has digit
+                1 + 2 * CELLS + col * SIZE + d,     // column has digit
+                1 + 3 * CELLS + box * SIZE + d,     // box has digit
+            };
+            row_start_[candidate] = static_cast<std::int16_t>(next);
+            for (int k = 0; k < 4; ++k) {
+                int node = next + k;
+                int header = columns[k];
+                // append to the bottom of the column
+                column_[node] = static_cast<std::int16_t>(header);
+                row_[node] = static_cast<std::int16_t>(candidate);
+                up_[node] = up_[header];
+                down_[node] = static_cast<std::int16_t>(header);
+                down_[up_[header]] = static_cast<std::int16_t>(node);
+                up_[header] = static_cast<std::int16_t>(node);
+                ++size_[header];
+                // circular row of four nodes
+                left_[node] = static_cast<std::int16_t>(next + (k + 3) % 4);
+                right_[node] = static_cast<std::int16_t>(next + (k + 1) % 4);
+            }
+            next += 4;
+        }
+    }
+}
+
+void DlxSolver::cover(int col) noexcept {
+    right_[left_[col]] = right_[col];
+    left_[right_[col]] = left_[col];
+    for (int i = down_[col]; i != col; i = down_[i]) {
+        for (int j = right_[i]; j != i; j = right_[j]) {
+            down_[up_[j]] = down_[j];
+            up_[down_[j]] = up_[j];
+            --size_[column_[j]];
+        }
+    }
+}
+
+void DlxSolver::uncover(int col) noexcept {
+    for (int i = up_[col]; i != col; i = up_[i]) {
+        for (int j = left_[i]; j != i; j = left_[j]) {
+            ++size_[column_[j]];
+            down_[up_[j]] = static_cast<std::int16_t>(j);
+            up_[down_[j]] = static_cast<std::int16_t>(j);
+        }
+    }
+    right_[left_[col]] = static_cast<std::int16_t>(col);
+    left_[right_[col]] = static_cast<std::int16_t>(col);
+}
+
+void DlxSolver::selectRow(int node) noexcept {
+    for (int j = right_[node]; j != node; j = right_[j]) {
+        cover(column_[j]);
+    }
+}
+
+void DlxSolver::unselectRow(int node) noexcept {
+    for (int j = left_[node]; j != node; j = left_[j]) {
+        uncover(column_[j]);
+    }
+}
+
+bool DlxSolver::selectGivens(const Grid& grid) noexcept {
+    given_count_ = 0;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        int value = grid[cell];
+        if (value == 0) continue;
+        if (value > SIZE) return false;
+        int node = row_start_[cell * SIZE + value - 1];
+        // every constraint of the given must still be open, otherwise it clashes with an earlier given
+        for (int k = 0; k < 4; ++k) {
+            if (!isActive(column_[node + k])) return false;
+        }
+        cover(column_[node]);
+        selectRow(node);
+        given_nodes_[given_count_++] = static_cast<std::int16_t>(node);
+    }
+    return true;
+}
+
+void DlxSolver::releaseGivens() noexcept {
+    while (given_count_ > 0) {
+        int node = given_nodes_[--given_count_];
+        unselectRow(node);
+        uncover(column_[node]);
+    }
+}
+
+bool DlxSolver::solve(Grid& grid, std::mt19937* rng) noexcept {
+    stats_ = {};
+    rng_ = rng;
+    depth_ = 0;
+    limit_ = 1;
+    solutions_ = 0;
+
+    bool found = selectGivens(grid) && search();
+    releaseGivens();
+    if (!found) return false;
+
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (grid[cell] == 0) {
+            grid[cell] = solution_[cell];
+        }
+    }
+    return true;
+}
+
+int DlxSolver::countSolutions(const Grid& grid, int limit) noexcept {
+    stats_ = {};
+    rng_ = nullptr;
+    depth_ = 0;
+    limit_ = limit;
+    solutions_ = 0;
+    if (limit > 0 && selectGivens(grid)) {
+        search();
+    }
+    releaseGivens();
+    return solutions_;
+}
+
+bool DlxSolver::search() noexcept {
+    ++stats_.nodes;
+    if (right_[ROOT] == ROOT) {
+        // every constraint is satisfied, record the chosen rows
+        for (int i = 0; i < depth_; ++i) {
+            int candidate = row_[partial_[i]];
+            solution_[candidate / SIZE] = static_cast<std::uint8_t>(candidate % SIZE + 1);
+        }
+        return ++solutions_ >= limit_;
+    }
+
+    // branch on the column with the fewest remaining rows
+    int best = right_[ROOT];
+    for (int col = right_[best]; col != ROOT; col = right_[col]) {
+        if (size_[col] < size_[best]) best = col;
+    }
+    if (size_[best] == 0) {
+        ++stats_.backtracks;
+        return false;
+    }
+    if (size_[best] == 1) {
+        ++stats_.forced;
+    }
+
+    cover(best);
+    std::array<std::int16_t, SIZE> rows{};
+    int num_rows = 0;
+    for (int i = down_[best]; i != best; i = down_[i]) {
+        rows[num_rows++] = static_cast<std::int16_t>(i);
+    }
+    if (rng_) {
+        std::shuffle(rows.begin(), rows.begin() + num_rows, *rng_);
+    }
+
+    bool found = false;
+    for (int k = 0; k < num_rows && !found; ++k) {
+        int node = rows[k];
+        partial_[depth_++] = static_cast<std::int16_t>(node);
+        selectRow(node);
+        found = search();
+        unselectRow(node);
+        --depth_;
+    }
+    uncover(best);
+
+    if (!found) ++stats_.backtracks;
+    return found;
+}
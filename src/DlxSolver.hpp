@@ -0,0 +1,68 @@
+#ifndef DLX_SOLVER_HPP
+#define DLX_SOLVER_HPP
+
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+
+// Knuth's Algorithm X with Dancing Links over the 324-column exact cover form of Sudoku:
+// one column per cell, per (row, digit), per (col, digit) and per (box, digit).
+// The 729x324 matrix is built once in the constructor; each solve covers the givens,
+// searches, then uncovers everything so the same node storage is reused by the next call.
+class DlxSolver {
+public:
+    using Grid = SudokuBoard::Grid;
+    using SolveStats = SudokuBoard::SolveStats;
+
+    DlxSolver() noexcept;
+
+    // Solve grid in place. Row order within a column is shuffled when rng is given.
+    // Returns false (leaving grid untouched) if the givens conflict or no solution exists.
+    bool solve(Grid& grid, std::mt19937* rng = nullptr) noexcept;
+
+    // Count solutions of grid, stopping as soon as limit are found (limit 2 answers "is it unique?").
+    int countSolutions(const Grid& grid, int limit) noexcept;
+
+    const SolveStats& getStats() const noexcept { return stats_; }
+
+private:
+    static constexpr int SIZE = SudokuBoard::SIZE;
+    static constexpr int CELLS = SudokuBoard::CELLS;
+    static constexpr int COLUMNS = 4 * CELLS;                 // 324 constraints
+    static constexpr int ROWS = CELLS * SIZE;                 // 729 (cell, digit) candidates
+    static constexpr int ROOT = 0;
+    static constexpr int NODES = 1 + COLUMNS + 4 * ROWS;      // root + headers + 4 nodes per row
+
+    void cover(int col) noexcept;
+    void uncover(int col) noexcept;
+    bool isActive(int col) const noexcept { return right_[left_[col]] == col; }
+    bool selectGivens(const Grid& grid) noexcept;   // cover givens, false on conflict
+    void releaseGivens() noexcept;                  // uncover givens in reverse order
+    void selectRow(int node) noexcept;              // cover every other column of node's row
+    void unselectRow(int node) noexcept;
+    bool search() noexcept;
+
+    // node links; indices [1, COLUMNS] are column headers
+    std::array<std::int16_t, NODES> left_{};
+    std::array<std::int16_t, NODES> right_{};
+    std::array<std::int16_t, NODES> up_{};
+    std::array<std::int16_t, NODES> down_{};
+    std::array<std::int16_t, NODES> column_{};
+    std::array<std::int16_t, NODES> row_{};          // candidate id = cell * SIZE + (digit - 1)
+    std::array<std::int16_t, COLUMNS + 1> size_{};   // live nodes per column
+    std::array<std::int16_t, ROWS> row_start_{};     // first node of each candidate row
+
+    std::array<std::int16_t, CELLS> given_nodes_{};  // rows selected for the givens
+    int given_count_ = 0;
+    std::array<std::int16_t, CELLS> partial_{};      // rows chosen by the search
+    int depth_ = 0;
+    Grid solution_{};
+    int limit_ = 1;                                  // stop after this many solutions
+    int solutions_ = 0;
+
+    std::mt19937* rng_ = nullptr;
+    SolveStats stats_{};
+};
+
+#endif // DLX_SOLVER_HPP
@@ -1,9 +1,13 @@
 #include "GameController.hpp"
 #include "GameUI.hpp" 
+#include "StepSolver.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stop_token>
 
 // The constructor now initializes the board reference and takes ownership of the UI pointer
-GameController::GameController(SudokuBoard& board, std::unique_ptr<IGameUI> ui) noexcept
-    : board_(board), ui_(std::move(ui)) {}
+GameController::GameController(SudokuBoard& board, std::unique_ptr<IGameUI> ui, PuzzlePool* pool) noexcept
+    : board_(board), ui_(std::move(ui)), pool_(pool) {}
 
 SudokuBoard::Difficulty GameController::selectDifficulty() noexcept {
     int selected_item = 0; // 0: Easy, 1: Medium, 2: Hard
@@ -30,7 +34,7 @@ SudokuBoard::Difficulty GameController::selectDifficulty() noexcept {
     }
 }
 
-void GameController::run() noexcept {
+void GameController::run() {
     // Show the one-time welcome screen
     if (auto* concrete_ui = dynamic_cast<GameUI*>(ui_.get())) {
         concrete_ui->displayWelcomeScreen();
@@ -40,14 +44,16 @@ void GameController::run() noexcept {
     SudokuBoard::Difficulty chosen_difficulty = selectDifficulty();
     
     // Generate a puzzle with the chosen difficulty
-    board_.generatePuzzle(chosen_difficulty);
+    startPuzzle(chosen_difficulty);
 
-    // Start the main game loop
+    // Start the main game loop; while a job runs the UI times out key reads so it gets polled
     while (is_running_) {
+        pollTask();
         ui_->displayBoard();
         int ch = ui_->getPressedKey();
         processInput(ch);
     }
+    cancelTask();
 }
 
 void GameController::handleSubmit() noexcept {
@@ -60,8 +66,7 @@ void GameController::handleSubmit() noexcept {
         ui_->displayMessage("Congratulations! You solved it!");
         is_running_ = false;
     } else {
-        auto errors = board_.findErrors();
-        ui_->setErrors(errors);
+        ui_->showErrors(true);
         ui_->displayMessage("Your mistakes are highlighted in red!");
     }
 }
@@ -74,7 +79,7 @@ void GameController::handleUndo() noexcept {
     }
 }
 
-void GameController::handleHint() noexcept {
+void GameController::handleHint() {
     auto [row, col] = ui_->getCursorPosition();
 
     // Check if the cell is part of the original puzzle
@@ -89,7 +94,43 @@ void GameController::handleHint() noexcept {
         return;
     }
     
-    // If checks pass, try to find a valid hint
+    // a known answer key makes the hint a lookup, otherwise the board is solved in the background
+    if (board_.hasAnswerKey()) {
+        applyHint(row, col);
+        return;
+    }
+    // the same two tries as SudokuBoard::getHint: the board without the hinted cell's own entry,
+    // which may be the wrong digit being asked about, then the givens alone
+    SudokuBoard::Grid grid{};
+    SudokuBoard::Grid givens{};
+    for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+        grid[cell] = board_.getBoard()[cell];
+        givens[cell] = board_.isPreFilled(cell / SudokuBoard::SIZE, cell % SudokuBoard::SIZE) ? grid[cell] : 0;
+    }
+    grid[row * SudokuBoard::SIZE + col] = 0;
+    const auto seed = std::random_device{}();
+    hint_row_ = row;
+    hint_col_ = col;
+    task_ = Task::Hint;
+    hint_job_.start([grid, givens, seed](std::stop_token stop) -> std::optional<SudokuBoard::Grid> {
+        std::mt19937 rng(seed);
+        StepSolver solver;
+        auto solve = [&](const SudokuBoard::Grid& start) -> std::optional<SudokuBoard::Grid> {
+            solver.start(start, &rng);
+            while (solver.step(HINT_SLICE) == StepSolver::Status::Running) {
+                if (stop.stop_requested()) return std::nullopt;
+            }
+            if (solver.getStatus() != StepSolver::Status::Solved) return std::nullopt;
+            return solver.getSolution();
+        };
+        if (auto solution = solve(grid)) return solution;
+        if (stop.stop_requested()) return std::nullopt;
+        return solve(givens);
+    });
+    ui_->showWorking("Finding a hint");
+}
+
+void GameController::applyHint(int row, int col) noexcept {
     std::random_device rd;
     std::mt19937 g(rd());
     auto hint = board_.getHint(row, col, g);
@@ -103,15 +144,117 @@ void GameController::handleHint() noexcept {
     }
 }
 
-void GameController::handleNewGame() noexcept {
-    board_.generatePuzzle(SudokuBoard::Difficulty::Easy);
-    ui_->setFocus(FocusState::BOARD);
-    ui_->displayMessage("New Easy game started!");
+void GameController::startPuzzle(SudokuBoard::Difficulty difficulty) noexcept {
+    if (pool_) {
+        pool_->take(difficulty, board_);
+    } else {
+        board_.generatePuzzle(difficulty);
+    }
+}
+
+void GameController::handleNewGame() {
+    // a pooled puzzle is a pop; generating one (or reading the library) happens in the background
+    PuzzlePool::Puzzle puzzle;
+    if (pool_ && pool_->tryTake(SudokuBoard::Difficulty::Easy, puzzle)) {
+        board_.loadPuzzle(puzzle.givens, &puzzle.solution);
+        ui_->setFocus(FocusState::BOARD);
+        ui_->displayMessage("New Easy game started!");
+        return;
+    }
+    const auto engine = board_.getSolverEngine();
+    PuzzlePool* pool = pool_;
+    task_ = Task::NewGame;
+    // the board polls the flag between cell removals, so a cancel only waits for one uniqueness check
+    game_job_.start([engine, pool](std::stop_token stop) -> std::optional<SudokuBoard> {
+        std::atomic<bool> cancelled{false};
+        std::stop_callback on_stop(stop, [&cancelled] { cancelled.store(true, std::memory_order_relaxed); });
+        SudokuBoard fresh;
+        fresh.setSolverEngine(engine);
+        fresh.setCancelFlag(&cancelled);
+        if (pool) {
+            pool->take(SudokuBoard::Difficulty::Easy, fresh);
+        } else {
+            fresh.generatePuzzle(SudokuBoard::Difficulty::Easy);
+        }
+        fresh.setCancelFlag(nullptr);   // the flag dies with this job
+        if (stop.stop_requested()) return std::nullopt;
+        return fresh;
+    });
+    ui_->showWorking("Making a puzzle");
+}
+
+void GameController::pollTask() {
+    if (task_ == Task::Hint ? hint_job_.isReady() : task_ == Task::NewGame && game_job_.isReady()) {
+        finishTask();
+    }
+}
+
+void GameController::waitForTask() {
+    if (task_ != Task::None) {
+        finishTask();
+    }
+}
+
+void GameController::cancelTask() noexcept {
+    if (task_ == Task::None) return;
+    hint_job_.cancel();
+    game_job_.cancel();
+    task_ = Task::None;
+    ui_->showWorking("");
+}
+
+void GameController::finishTask() {
+    const Task task = task_;
+    task_ = Task::None;
+    ui_->showWorking("");
+    if (task == Task::Hint) {
+        // edits are refused while the job runs, so the solution still fits the givens
+        auto solution = hint_job_.take();
+        if (solution && board_.adoptSolution(*solution)) {
+            applyHint(hint_row_, hint_col_);
+        } else {
+            ui_->displayMessage("No hint available. Check for mistakes on the board.");
+        }
+    } else if (task == Task::NewGame) {
+        if (auto fresh = game_job_.take()) {
+            board_ = *fresh;
+        }
+        ui_->setFocus(FocusState::BOARD);
+        ui_->displayMessage("New Easy game started!");
+    }
+}
+
+bool GameController::processBusyInput(int ch) noexcept {
+    switch (ch) {
+        case CANCEL_KEY:
+            cancelTask();
+            ui_->displayMessage("Cancelled.");
+            return true;
+        case 'q':
+        case 'Q':
+            cancelTask();
+            is_running_ = false;
+            return true;
+        case '\t':
+        case KEY_RIGHT:
+        case KEY_LEFT:
+        case KEY_UP:
+        case KEY_DOWN:
+            return false;           // moving around works as usual
+        case ERR:
+        case 0:
+            return true;            // key wait timed out, or nothing was pressed
+        default:
+            ui_->flashScreen();     // edits and menu actions wait for the job
+            return true;
+    }
 }
 
-void GameController::processInput(int ch) noexcept {        
+void GameController::processInput(int ch) {        
+    if (task_ != Task::None && processBusyInput(ch)) return;
+    if (ch == ERR) return;      // a timed-out key wait
     if (ui_->getFocus() == FocusState::BOARD) {
-        ui_->setErrors({});
+        ui_->showErrors(false);
         auto [row, col] = ui_->getCursorPosition();
         switch (ch) {
             case 'q':
@@ -1,29 +1,56 @@
 #ifndef GAME_CONTROLLER_HPP
 #define GAME_CONTROLLER_HPP
 
+#include "AsyncJob.hpp"
 #include "SudokuBoard.hpp"
 #include "IGameUI.hpp"
+#include "PuzzlePool.hpp"
 #include <memory> // Required for std::unique_ptr
 
+// Hints that need a solve and new games the pool cannot serve right away run as background
+// jobs. While one runs the loop keeps redrawing and reading keys: the cursor still moves, Esc
+// cancels the job and q quits, other keys are refused until the result has been applied.
 class GameController {
 public:
-    explicit GameController(SudokuBoard& board, std::unique_ptr<IGameUI> ui) noexcept;
+    static constexpr int CANCEL_KEY = 27;           // Esc
+    static constexpr std::uint64_t HINT_SLICE = 256;    // search nodes between cancellation checks
+
+    // with a pool, new games are taken from it instead of generated on the UI thread
+    explicit GameController(SudokuBoard& board, std::unique_ptr<IGameUI> ui, PuzzlePool* pool = nullptr) noexcept;
     
-    void run() noexcept;
+    void run();
     bool isRunning() const noexcept { return is_running_; }
+    bool isBusy() const noexcept { return task_ != Task::None; }   // a background job is in flight
 
-    void processInput(int ch) noexcept;     // Process input based on current focus
+    void processInput(int ch);     // Process input based on current focus
     SudokuBoard::Difficulty selectDifficulty() noexcept;        // method to select difficulty
 
+    void pollTask();               // apply the background job's result if it is ready
+    void waitForTask();            // block until the background job is done and applied
+    void cancelTask() noexcept;             // stop the background job and drop its result
+
 private:
+    enum class Task { None, Hint, NewGame };
+
     void handleSubmit() noexcept;           // Handle submit action
-    void handleHint() noexcept;             // Handle hint action
+    void handleHint();             // Handle hint action
     void handleUndo() noexcept;             // Handle undo action
-    void handleNewGame() noexcept;          // Handle new game action
+    void handleNewGame();          // Handle new game action
+    void startPuzzle(SudokuBoard::Difficulty difficulty) noexcept;  // from the pool when there is one
+    bool processBusyInput(int ch) noexcept; // keys while a background job runs, false to handle as usual
+    void applyHint(int row, int col) noexcept;      // the board's answer key is known by now
+    void finishTask();             // take the ready result and apply it
 
     SudokuBoard& board_;
     std::unique_ptr<IGameUI> ui_; // Owns a UI that implements the interface
+    PuzzlePool* pool_ = nullptr;  // not owned, may be null
     bool is_running_ = true;
+
+    Task task_ = Task::None;
+    int hint_row_ = 0;                              // cell the pending hint is for
+    int hint_col_ = 0;
+    AsyncJob<SudokuBoard::Grid> hint_job_;          // solution of the board as it was
+    AsyncJob<SudokuBoard> game_job_;                // a fresh game
 };
 
-#endif // GAME_CONTROLLER_HPP
\ No newline at end of file
+#endif // GAME_CONTROLLER_HPP
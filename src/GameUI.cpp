@@ -2,10 +2,22 @@
 #include <string>
 #include <unistd.h> // for isatty
 #include <stdio.h>  // for fileno
-#include <set>
+#include <cstring>  // for strlen
 
 GameUI::GameUI(SudokuBoard& board) noexcept : board_(board), window_(nullptr) {
     window_ = initscr();
+    setUp();
+}
+
+GameUI::GameUI(SudokuBoard& board, FILE* out, FILE* in, const char* term) noexcept : board_(board), window_(nullptr) {
+    screen_ = newterm(term, out, in);
+    if (screen_) {
+        window_ = stdscr;
+    }
+    setUp();
+}
+
+void GameUI::setUp() noexcept {
     if (!window_) {
         return;
     }
@@ -22,24 +34,28 @@ GameUI::GameUI(SudokuBoard& board) noexcept : board_(board), window_(nullptr) {
     cbreak();
     curs_set(0); 
     mousemask(0, NULL);
+    set_escdelay(25);       // Esc cancels background work, don't wait a second for a key sequence
 
     // --- Creating sub-windows for board and menu ---
     int yMax, xMax;
     getmaxyx(window_, yMax, xMax);
 
     // Windows dimensions
-    constexpr int BOARD_WIN_HEIGHT = 19;         // 9 * 2 + 1
-    constexpr int BOARD_WIN_WIDTH = 37;          // 9 * 4 + 1
-    constexpr int MENU_WIN_WIDTH = 25;
+    constexpr int BOARD_WIN_HEIGHT = SudokuBoard::SIZE * CELL_HEIGHT + 1;
+    constexpr int BOARD_WIN_WIDTH = SudokuBoard::SIZE * CELL_WIDTH + 1;
     constexpr int SPACING = 2;
 
     // Center the whole layout
-    int total_layout_width = BOARD_WIN_WIDTH + SPACING + MENU_WIN_WIDTH;
+    int total_layout_width = BOARD_WIN_WIDTH + SPACING + MENU_WIDTH;
     int start_y = (yMax - BOARD_WIN_HEIGHT) / 2;
     int start_x = (xMax - total_layout_width) / 2;
 
     board_win_ = newwin(BOARD_WIN_HEIGHT, BOARD_WIN_WIDTH, start_y, start_x);
-    menu_win_ = newwin(BOARD_WIN_HEIGHT, MENU_WIN_WIDTH, start_y, start_x + BOARD_WIN_WIDTH + SPACING);
+    menu_win_ = newwin(BOARD_WIN_HEIGHT, MENU_WIDTH, start_y, start_x + BOARD_WIN_WIDTH + SPACING);
+    // the cursor is hidden, so updates need not move it back after drawing
+    leaveok(window_, TRUE);
+    leaveok(board_win_, TRUE);
+    leaveok(menu_win_, TRUE);
 }
 
 GameUI::~GameUI() noexcept {
@@ -52,15 +68,25 @@ GameUI::~GameUI() noexcept {
     if (window_) {
         endwin();
     }
+    if (screen_) {
+        delscreen(screen_);
+    }
 }
 
 void GameUI::displayBoard() const noexcept {
     if (!window_ || !board_win_ || !menu_win_) return;
-    werase(window_); // Clear the main screen
-    wrefresh(window_);
-
-    drawBoardWindow(); // Draw the board in its window
-    drawMenuWindow();  // Draw the menu in its window
+    const bool all = !frame_drawn_;
+    if (all) {
+        drawFrame();
+    }
+    drawCells();
+    drawMenuItems(all);
+    drawWorking(all);
+
+    // one flush for every window that changed
+    wnoutrefresh(board_win_);
+    wnoutrefresh(menu_win_);
+    doupdate();
 }
 
 void GameUI::displayWelcomeScreen() const noexcept {
@@ -84,6 +110,7 @@ void GameUI::displayWelcomeScreen() const noexcept {
 
     wattroff(window_, COLOR_PAIR(4));   
     wrefresh(window_);
+    frame_drawn_ = false;
 
     wgetch(window_); 
 }
@@ -117,62 +144,47 @@ void GameUI::displayDifficultyMenu(int selected_difficulty) const noexcept {
     
     wattroff(window_, COLOR_PAIR(4));
     wrefresh(window_);
+    frame_drawn_ = false;
 }
 
-void GameUI::setErrors(const std::vector<std::pair<int, int>>& errors) noexcept {
-    error_cells_ = errors;
+void GameUI::showErrors(bool show) noexcept {
+    show_errors_ = show;
 }
 
-void GameUI::drawBoardWindow() const noexcept {
-    werase(board_win_);
-
-    std::set<std::pair<int, int>> error_set(error_cells_.begin(), error_cells_.end());
-
-    // Draw grid lines
-    for (int i = 0; i <= 9; ++i) {
-        if (i % 3 == 0) wattron(board_win_, A_BOLD);
-        mvwvline(board_win_, 0, i * 4, ACS_VLINE, 19);
-        mvwhline(board_win_, i * 2, 0, ACS_HLINE, 37);
-        if (i % 3 == 0) wattroff(board_win_, A_BOLD);
+void GameUI::showWorking(const std::string& task) noexcept {
+    working_ = task;
+    if (window_) {
+        // wake up regularly while working so the controller can pick up the result
+        wtimeout(window_, task.empty() ? -1 : WORKING_POLL_MS);
     }
+}
 
-    // Draw cell contents
-    for (int row = 0; row < 9; ++row) {
-        for (int col = 0; col < 9; ++col) {
-            int value = board_.getCell(row, col);
-            char ch = (value == 0) ? '.' : ('0' + value);
-
-            int attribute = A_NORMAL;
-            // Check for error first, as it has the highest priority
-            if (error_set.count({row, col})) {
-                attribute = COLOR_PAIR(3); // Red for error
-            } else if (board_.isPreFilled(row, col)) {
-                attribute = COLOR_PAIR(1); // Blue for pre-filled
-            } else if (value != 0) {
-                attribute = COLOR_PAIR(2); // Yellow for user-entered
-            }
-
-            if (focus_ == FocusState::BOARD && row == cursor_row_ && col == cursor_col_) {
-                attribute |= A_REVERSE;
-            }
-
-            wattron(board_win_, attribute);
-            mvwaddch(board_win_, row * 2 + 1, col * 4 + 2, ch);
-            wattroff(board_win_, attribute);
-        }
+void GameUI::drawFrame() const noexcept {
+    // blank whatever the last full-screen page left around the layout
+    werase(window_);
+    wnoutrefresh(window_);
+
+    werase(board_win_);
+    // Draw grid lines; each cell is CELL_WIDTH x CELL_HEIGHT characters, box edges in bold
+    constexpr int SIZE = SudokuBoard::SIZE;
+    for (int i = 0; i <= SIZE; ++i) {
+        int vertical = i % SudokuBoard::BOX_COLS == 0 ? A_BOLD : A_NORMAL;
+        wattron(board_win_, vertical);
+        mvwvline(board_win_, 0, i * CELL_WIDTH, ACS_VLINE, SIZE * CELL_HEIGHT + 1);
+        wattroff(board_win_, vertical);
+        int horizontal = i % SudokuBoard::BOX_ROWS == 0 ? A_BOLD : A_NORMAL;
+        wattron(board_win_, horizontal);
+        mvwhline(board_win_, i * CELL_HEIGHT, 0, ACS_HLINE, SIZE * CELL_WIDTH + 1);
+        wattroff(board_win_, horizontal);
     }
-    
     box(board_win_, 0, 0);
-    wrefresh(board_win_);
-}
 
-void GameUI::drawMenuWindow() const noexcept {
     werase(menu_win_);
     box(menu_win_, 0, 0);
 
     // Title
     wattron(menu_win_, A_BOLD | COLOR_PAIR(4));
-    mvwprintw(menu_win_, 1, (25 - 10) / 2, "[ MATRIX ]");
+    mvwprintw(menu_win_, 1, (MENU_WIDTH - 10) / 2, "[ MATRIX ]");
     wattroff(menu_win_, A_BOLD | COLOR_PAIR(4));
 
     // Controls
@@ -182,17 +194,70 @@ void GameUI::drawMenuWindow() const noexcept {
     mvwprintw(menu_win_, 6, 3, "Enter : Select Action");
 
     mvwprintw(menu_win_, 9, 2, "[ ACTIONS ]");
+
+    drawn_cells_.fill(CellView{});      // every cell differs from "never drawn"
+    frame_drawn_ = true;
+}
+
+GameUI::CellView GameUI::cellView(int row, int col) const noexcept {
+    int value = board_.getCell(row, col);
+    chtype ch = (value == 0) ? '.' : value <= 9 ? ('0' + value) : ('A' + value - 10);
+
+    int attribute = A_NORMAL;
+    // Check for error first, as it has the highest priority
+    if (show_errors_ && board_.isInConflict(row, col)) {
+        attribute = COLOR_PAIR(3); // Red for error
+    } else if (board_.isPreFilled(row, col)) {
+        attribute = COLOR_PAIR(1); // Blue for pre-filled
+    } else if (value != 0) {
+        attribute = COLOR_PAIR(2); // Yellow for user-entered
+    }
+
+    if (focus_ == FocusState::BOARD && row == cursor_row_ && col == cursor_col_) {
+        attribute |= A_REVERSE;
+    }
+    return {ch, attribute};
+}
+
+void GameUI::drawCells() const noexcept {
+    constexpr int SIZE = SudokuBoard::SIZE;
+    for (int row = 0; row < SIZE; ++row) {
+        for (int col = 0; col < SIZE; ++col) {
+            CellView view = cellView(row, col);
+            CellView& drawn = drawn_cells_[row * SIZE + col];
+            if (view == drawn) continue;
+            mvwaddch(board_win_, row * CELL_HEIGHT + 1, col * CELL_WIDTH + 2, view.ch | static_cast<chtype>(view.attribute));
+            drawn = view;
+        }
+    }
+}
+
+void GameUI::drawMenuItems(bool all) const noexcept {
+    const int highlight = focus_ == FocusState::MENU ? selected_menu_item_ : -1;
     for (size_t i = 0; i < menu_items_.size(); ++i) {
-        if (focus_ == FocusState::MENU && i == static_cast<size_t>(selected_menu_item_)) {
+        const int item = static_cast<int>(i);
+        if (!all && (item == highlight) == (item == drawn_highlight_)) continue;
+        if (item == highlight) {
             wattron(menu_win_, COLOR_PAIR(5)); // Highlight selected item
         }
-        mvwprintw(menu_win_, 10 + i, 3, menu_items_[i].c_str());
-        if (focus_ == FocusState::MENU && i == static_cast<size_t>(selected_menu_item_)) {
+        mvwprintw(menu_win_, 10 + item, 3, "%s", menu_items_[i].c_str());
+        if (item == highlight) {
             wattroff(menu_win_, COLOR_PAIR(5));
         }
     }
+    drawn_highlight_ = highlight;
+}
 
-    wrefresh(menu_win_);
+void GameUI::drawWorking(bool all) const noexcept {
+    if (!all && working_ == drawn_working_) return;
+    // padded to the border so a shorter note hides a longer one
+    constexpr int WIDTH = MENU_WIDTH - 3;
+    const std::string note = working_.empty() ? std::string() : working_ + "...";
+    wattron(menu_win_, COLOR_PAIR(2));
+    mvwprintw(menu_win_, WORKING_ROW, 2, "%-*.*s", WIDTH, WIDTH, note.c_str());
+    mvwprintw(menu_win_, WORKING_ROW + 1, 2, "%-*s", WIDTH, working_.empty() ? "" : " Esc   : Cancel");
+    wattroff(menu_win_, COLOR_PAIR(2));
+    drawn_working_ = working_;
 }
 
 void GameUI::displayMessage(const std::string& message) const noexcept {
@@ -216,6 +281,7 @@ void GameUI::displayMessage(const std::string& message) const noexcept {
         wgetch(window_); // This will now only be called during manual play
 
         delwin(msg_win);
+        frame_drawn_ = false;   // the box covered part of the layout
     }
 }
 
@@ -4,10 +4,19 @@
 #include <ncurses.h>
 #include "SudokuBoard.hpp"
 #include "IGameUI.hpp" 
+#include <array>
+#include <cstdio>
 
+// Frames are drawn incrementally: the grid lines and menu text are drawn once, then each
+// displayBoard compares every cell, menu line and the working note with what was last put
+// on screen and rewrites only the ones that differ. All windows go out in one doupdate, so
+// moving the cursor costs two cells' worth of terminal output. Full-screen pages (welcome,
+// difficulty menu, message boxes) paint over the layout and force the next frame to start over.
 class GameUI : public IGameUI { // inheriting from IGameUI
 public:
     explicit GameUI(SudokuBoard& board) noexcept;
+    // draw to out and read from in with terminal type term (nullptr reads $TERM) instead of the tty
+    GameUI(SudokuBoard& board, FILE* out, FILE* in, const char* term = nullptr) noexcept;
     ~GameUI() noexcept override;
     GameUI(const GameUI&) = delete;
     GameUI& operator=(const GameUI&) = delete;
@@ -23,7 +32,8 @@ public:
     void setFocus(FocusState new_focus) noexcept override;
     void setCursorPosition(int row, int col) noexcept override;
     void setSelectedMenuItem(int item) noexcept override;
-    void setErrors(const std::vector<std::pair<int, int>>& errors) noexcept override;
+    void showErrors(bool show) noexcept override;
+    void showWorking(const std::string& task) noexcept override;
 
     // --- State Getters (needed by GameController) ---
     std::pair<int, int> getCursorPosition() const noexcept override;
@@ -32,26 +42,52 @@ public:
     int getSelectedMenuItem() const noexcept override;
     
     void displayWelcomeScreen() const noexcept;
-    const std::vector<std::vector<int>>& getBoard() const noexcept { return board_.getBoard(); }
+    SudokuBoard::GridView getBoard() const noexcept { return board_.getBoard(); }
     std::string getLastMessage() const { return last_message_; }
 
 
 protected:
-    void drawBoardWindow() const noexcept; 
-    void drawMenuWindow() const noexcept;
+    static constexpr int CELL_WIDTH = 4;        // board window columns per cell
+    static constexpr int CELL_HEIGHT = 2;       // board window rows per cell
+    static constexpr int WORKING_POLL_MS = 100; // key wait while a background task runs
+
+    static constexpr int MENU_WIDTH = 25;       // menu window columns
+    static constexpr int WORKING_ROW = 16;      // menu line of the working note, the cancel key below it
+
+    // what a cell looked like when last drawn; attribute -1 means never drawn
+    struct CellView {
+        chtype ch = 0;
+        int attribute = -1;
+        bool operator==(const CellView&) const = default;
+    };
+
+    void setUp() noexcept;                      // colours, input modes and the sub-windows
+    void drawFrame() const noexcept;            // everything that does not change between frames
+    void drawCells() const noexcept;            // cells whose look changed since the last frame
+    void drawMenuItems(bool all) const noexcept;
+    void drawWorking(bool all) const noexcept;
+    CellView cellView(int row, int col) const noexcept;
 
     SudokuBoard& board_;                        // Reference to board
     WINDOW* window_;                            // ncurses window
+    SCREEN* screen_ = nullptr;                  // only when drawing to a given stream
     int cursor_row_ = 0;                        // Cursor position row
     int cursor_col_ = 0;                        // Cursor position col
     FocusState focus_ = FocusState::BOARD;      // Start with focus on the board
     int selected_menu_item_ = 0;                // Selected menu item index
     const std::vector<std::string> menu_items_ = {"Submit", "Undo", "Hint", "New Game", "Quit"};
     mutable std::string last_message_;         // Store last message for testing
-    std::vector<std::pair<int, int>> error_cells_;  // Cells that are in error state
+    bool show_errors_ = false;                  // highlight cells the board reports in conflict
+    std::string working_;                       // background task shown in the menu, empty when idle
 
     WINDOW* board_win_ = nullptr; 
     WINDOW* menu_win_ = nullptr;
+
+    // what is on screen, so a frame only rewrites the difference
+    mutable bool frame_drawn_ = false;          // chrome is up and the caches below are valid
+    mutable std::array<CellView, SudokuBoard::CELLS> drawn_cells_{};
+    mutable int drawn_highlight_ = -1;          // highlighted menu item, -1 for none
+    mutable std::string drawn_working_;
 };
 
 #endif // GAME_UI_HPP
\ No newline at end of file
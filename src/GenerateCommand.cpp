@@ -0,0 +1,338 @@
+#include "GenerateCommand.hpp"
+#include "BoundedQueue.hpp"
+#include "CanonicalIndex.hpp"
+#include "GridTransform.hpp"
+#include "PuzzleArchive.hpp"
+#include "PuzzleCorpus.hpp"
+#include "SearchSolver.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t FLUSH_BYTES = 1u << 20;      // output buffered this much between writes
+
+// what travels between stages; the solution rides along so dig needs no solve of its own
+struct Item {
+    SudokuBoard::Grid puzzle;
+    SudokuBoard::Grid solution;
+    std::uint8_t rating;
+};
+
+struct alignas(64) StageCounters {
+    std::atomic<std::uint64_t> items{0};
+    std::atomic<std::uint64_t> busy_ns{0};
+    std::atomic<std::uint64_t> full_waits{0};
+    std::atomic<std::uint64_t> empty_waits{0};
+    std::atomic<unsigned> live{0};                  // threads still running
+};
+
+void push(BoundedQueue<Item>& queue, const Item& item, StageCounters& counters) noexcept {
+    while (!queue.tryPush(item)) {
+        counters.full_waits.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+    }
+}
+
+// false once the upstream stage has finished and its queue is drained
+bool pull(BoundedQueue<Item>& queue, const StageCounters& upstream, Item& item, StageCounters& counters) noexcept {
+    while (!queue.tryPop(item)) {
+        if (upstream.live.load(std::memory_order_acquire) == 0) {
+            return queue.tryPop(item);      // a last push may have landed after the failed pop
+        }
+        counters.empty_waits.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+std::optional<SudokuBoard::Difficulty> parseDifficulty(std::string_view name) noexcept {
+    if (name == "easy") return SudokuBoard::Difficulty::Easy;
+    if (name == "medium") return SudokuBoard::Difficulty::Medium;
+    if (name == "hard") return SudokuBoard::Difficulty::Hard;
+    return std::nullopt;
+}
+
+} // namespace
+
+GenerateCommand::GenerateCommand(Options options) noexcept : options_(options) {
+    for (unsigned& threads : options_.threads) threads = std::max(1u, threads);
+    options_.threads[OUTPUT] = 1;
+}
+
+std::array<unsigned, GenerateCommand::STAGES> GenerateCommand::defaultThreads() noexcept {
+    // digging runs a uniqueness check per removed clue and dominates; the rest keep up on one thread each
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    return {1, std::max(1u, cores > 3 ? cores - 3 : 1), 1, 1};
+}
+
+GenerateCommand::Difficulty GenerateCommand::rate(const Grid& puzzle) noexcept {
+    thread_local SearchSolver solver;       // rated once per puzzle, so the trail is allocated once per thread
+    Grid grid = puzzle;
+    solver.solve(grid);
+    const auto& stats = solver.getStats();
+    if (stats.nodes > 1) return Difficulty::Hard;
+    if (stats.pointing_eliminations + stats.claiming_eliminations > 0) return Difficulty::Medium;
+    return Difficulty::Easy;
+}
+
+GenerateCommand::Report GenerateCommand::run(std::ostream& out) {
+    const auto start = Clock::now();
+    const std::uint32_t seed = options_.seed != 0 ? options_.seed : std::random_device{}();
+    const int to_remove = SudokuBoard::removalTarget(options_.difficulty);
+
+    std::array<StageCounters, STAGES> counters;
+    BoundedQueue<Item> filled(options_.queue_capacity);
+    BoundedQueue<Item> dug(options_.queue_capacity);
+    BoundedQueue<Item> rated(options_.queue_capacity);
+    std::atomic<bool> enough{options_.count == 0};    // output has everything it needs, fill stops
+    Report report;
+
+    auto timed = [](StageCounters& stage, auto&& work) {
+        auto begin = Clock::now();
+        work();
+        stage.busy_ns.fetch_add(static_cast<std::uint64_t>((Clock::now() - begin).count()), std::memory_order_relaxed);
+        stage.items.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    auto fillStage = [&](unsigned index) {
+        std::seed_seq seq{seed, static_cast<std::uint32_t>(FILL), index};
+        std::mt19937 rng(seq);
+        SearchSolver solver;
+        Item item{};
+        while (!enough.load(std::memory_order_relaxed)) {
+            timed(counters[FILL], [&] {
+                item.solution = {};
+                solver.solve(item.solution, &rng);
+            });
+            push(filled, item, counters[FILL]);
+        }
+    };
+
+    auto digStage = [&](unsigned index) {
+        std::seed_seq seq{seed, static_cast<std::uint32_t>(DIG), index};
+        std::mt19937 rng(seq);
+        SudokuBoard board;
+        Item item{};
+        while (pull(filled, counters[FILL], item, counters[DIG])) {
+            if (enough.load(std::memory_order_relaxed)) continue;   // drain without working
+            timed(counters[DIG], [&] {
+                board.loadPuzzle(item.solution);
+                board.removeCells(to_remove, rng);
+                std::copy(board.getBoard().begin(), board.getBoard().end(), item.puzzle.begin());
+            });
+            push(dug, item, counters[DIG]);
+        }
+    };
+
+    auto rateStage = [&](unsigned index) {
+        std::seed_seq seq{seed, static_cast<std::uint32_t>(RATE), index};
+        std::mt19937 rng(seq);
+        Item item{};
+        Item variant{};
+        while (pull(dug, counters[DIG], item, counters[RATE])) {
+            if (enough.load(std::memory_order_relaxed)) continue;
+            timed(counters[RATE], [&] { item.rating = static_cast<std::uint8_t>(rate(item.puzzle)); });
+            push(rated, item, counters[RATE]);
+            // symmetry images share the rating, so they skip straight to output
+            for (std::size_t v = 1; v < options_.variants && !enough.load(std::memory_order_relaxed); ++v) {
+                GridTransform transform = GridTransform::random(rng);
+                transform.apply(item.puzzle, variant.puzzle);
+                transform.apply(item.solution, variant.solution);
+                variant.rating = item.rating;
+                push(rated, variant, counters[RATE]);
+            }
+        }
+    };
+
+    auto outputStage = [&](unsigned) {
+        CanonicalIndex seen(options_.count);
+        std::string buffer;
+        buffer.reserve(FLUSH_BYTES + SudokuBoard::CELLS + 1);
+        std::vector<PuzzleArchive::Entry> entries;
+        if (options_.archive) {
+            entries.reserve(options_.count);
+        } else if (options_.packed) {
+            PuzzleCorpus::writePackedHeader(out);
+        }
+        Item item{};
+        while (pull(rated, counters[RATE], item, counters[OUTPUT])) {
+            if (report.written == options_.count) continue;
+            timed(counters[OUTPUT], [&] {
+                if (!seen.insert(CanonicalIndex::fingerprint(item.puzzle))) {
+                    ++report.duplicates;
+                    return;
+                }
+                if (options_.archive) {
+                    entries.push_back({static_cast<Difficulty>(item.rating), item.puzzle, item.solution});
+                } else if (options_.packed) {
+                    std::uint8_t record[PuzzleCorpus::PACKED_RECORD_SIZE];
+                    PuzzleCorpus::pack(item.puzzle, record);
+                    buffer.append(reinterpret_cast<const char*>(record), sizeof(record));
+                } else {
+                    for (std::uint8_t value : item.puzzle) buffer.push_back(value == 0 ? '.' : static_cast<char>('0' + value));
+                    buffer.push_back('\n');
+                }
+                ++report.ratings[item.rating];
+                if (++report.written == options_.count) enough.store(true, std::memory_order_relaxed);
+                if (buffer.size() >= FLUSH_BYTES) {
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            });
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (options_.archive) PuzzleArchive::write(out, entries, true);
+    };
+
+    // each stage's live count drops to zero when its last thread exits, which ends the next stage
+    std::vector<std::thread> threads;
+    auto launch = [&](Stage stage, auto body) {
+        counters[stage].live.store(options_.threads[stage], std::memory_order_relaxed);
+        for (unsigned i = 0; i < options_.threads[stage]; ++i) {
+            threads.emplace_back([&counters, stage, body, i] {
+                body(i);
+                counters[stage].live.fetch_sub(1, std::memory_order_release);
+            });
+        }
+    };
+    launch(FILL, fillStage);
+    launch(DIG, digStage);
+    launch(RATE, rateStage);
+    launch(OUTPUT, outputStage);
+
+    // sample occupancy until the output stage is done
+    const std::array<const BoundedQueue<Item>*, STAGES - 1> queues = {&filled, &dug, &rated};
+    std::array<double, STAGES - 1> occupancy_sum{};
+    std::size_t samples = 0;
+    while (counters[OUTPUT].live.load(std::memory_order_acquire) != 0) {
+        for (std::size_t q = 0; q < queues.size(); ++q) {
+            std::size_t size = queues[q]->size();
+            occupancy_sum[q] += static_cast<double>(size);
+            report.queues[q].max = std::max(report.queues[q].max, size);
+        }
+        ++samples;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (auto& thread : threads) thread.join();
+
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (int stage = 0; stage < STAGES; ++stage) {
+        auto& result = report.stages[stage];
+        result.threads = options_.threads[stage];
+        result.items = counters[stage].items.load();
+        result.busy_seconds = static_cast<double>(counters[stage].busy_ns.load()) * 1e-9;
+        result.full_waits = counters[stage].full_waits.load();
+        result.empty_waits = counters[stage].empty_waits.load();
+    }
+    for (std::size_t q = 0; q < queues.size(); ++q) {
+        report.queues[q].capacity = queues[q]->capacity();
+        report.queues[q].mean = samples ? occupancy_sum[q] / static_cast<double>(samples) : 0.0;
+    }
+    return report;
+}
+
+void GenerateCommand::printReport(const Report& report, std::ostream& out) {
+    static constexpr const char* NAMES[STAGES] = {"fill", "dig", "rate", "output"};
+    const double rate = report.seconds > 0.0 ? static_cast<double>(report.written) / report.seconds : 0.0;
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "generated %zu puzzles (%zu duplicates dropped) in %.3f s: %.0f puzzles/s\n"
+                  "rated: %zu easy, %zu medium, %zu hard\n"
+                  "stage   threads     items   items/s  per-thread/s   full-waits  empty-waits   in-queue mean/max/cap\n",
+                  report.written, report.duplicates, report.seconds, rate,
+                  report.ratings[0], report.ratings[1], report.ratings[2]);
+    out << buffer;
+    for (int stage = 0; stage < STAGES; ++stage) {
+        const auto& s = report.stages[stage];
+        double throughput = report.seconds > 0.0 ? static_cast<double>(s.items) / report.seconds : 0.0;
+        double per_thread = s.busy_seconds > 0.0 ? static_cast<double>(s.items) / s.busy_seconds : 0.0;
+        std::snprintf(buffer, sizeof(buffer), "%-7s %7u %9llu %9.0f %13.0f %12llu %12llu",
+                      NAMES[stage], s.threads, static_cast<unsigned long long>(s.items), throughput, per_thread,
+                      static_cast<unsigned long long>(s.full_waits), static_cast<unsigned long long>(s.empty_waits));
+        out << buffer;
+        if (stage > 0) {
+            const auto& q = report.queues[stage - 1];
+            std::snprintf(buffer, sizeof(buffer), "   %8.1f/%zu/%zu", q.mean, q.max, q.capacity);
+            out << buffer;
+        }
+        out << '\n';
+    }
+}
+
+int GenerateCommand::main(int argc, char** argv) {
+    static constexpr const char* USAGE =
+        "usage: sudoku generate COUNT [-o FILE] [-d easy|medium|hard] [--packed|--archive] [--variants N]\n"
+        "                       [--fill N] [--dig N] [--rate N] [--queue N] [--seed N]\n";
+    Options options;
+    std::string output = "-";
+    bool have_count = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-h" || arg == "--help") {
+            std::cout << USAGE;
+            return 0;
+        } else if (arg == "--packed") {
+            options.packed = true;
+        } else if (arg == "--archive") {
+            options.archive = true;
+        } else if (has_value && (arg == "-o" || arg == "--output")) {
+            output = argv[++i];
+        } else if (has_value && (arg == "-d" || arg == "--difficulty")) {
+            auto difficulty = parseDifficulty(argv[++i]);
+            if (!difficulty) {
+                std::cerr << USAGE;
+                return 2;
+            }
+            options.difficulty = *difficulty;
+        } else if (has_value && arg == "--fill") {
+            options.threads[FILL] = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (has_value && arg == "--dig") {
+            options.threads[DIG] = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (has_value && arg == "--rate") {
+            options.threads[RATE] = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (has_value && arg == "--variants") {
+            options.variants = static_cast<std::size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (has_value && arg == "--queue") {
+            options.queue_capacity = static_cast<std::size_t>(std::max(2, std::atoi(argv[++i])));
+        } else if (has_value && arg == "--seed") {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!have_count && !arg.empty() && arg[0] != '-') {
+            options.count = static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10));
+            have_count = true;
+        } else {
+            std::cerr << USAGE;
+            return 2;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    GenerateCommand generator(options);
+    Report report;
+    if (output == "-") {
+        report = generator.run(std::cout);
+        std::cout.flush();
+    } else {
+        std::ofstream file(output, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "sudoku generate: cannot write " << output << "\n";
+            return 1;
+        }
+        report = generator.run(file);
+    }
+    printReport(report, std::cerr);
+    return report.written == options.count ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#ifndef GENERATE_COMMAND_HPP
+#define GENERATE_COMMAND_HPP
+
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <thread>
+
+// Offline puzzle generation for `sudoku generate`. generatePuzzle's three jobs run as separate
+// pipeline stages, each with its own threads, connected by BoundedQueues:
+//   fill   - random full grids from the MRV search
+//   dig    - remove clues toward the difficulty target while the solution stays unique
+//   rate   - grade each puzzle by the hardest technique the MRV propagation needed, then
+//            optionally emit extra variants through random GridTransforms (same grade, same
+//            uniqueness, no search)
+//   output - drop repeats and write the puzzles (one thread, so the stream stays ordered); an
+//            archive is held back until the end, since its header indexes every difficulty
+// A full queue makes its producer wait and an empty one makes its consumer wait; the report
+// counts both, together with sampled queue occupancy, so a slow stage is easy to spot.
+class GenerateCommand {
+public:
+    using Grid = SudokuBoard::Grid;
+    using Difficulty = SudokuBoard::Difficulty;
+
+    enum Stage { FILL, DIG, RATE, OUTPUT, STAGES };
+
+    struct Options {
+        std::size_t count = 1000;                           // puzzles to write
+        Difficulty difficulty = Difficulty::Medium;         // clue removal target
+        std::array<unsigned, STAGES> threads = defaultThreads();   // OUTPUT is always one thread
+        std::size_t queue_capacity = 256;                   // per queue, rounded up to a power of two
+        std::size_t variants = 1;                           // puzzles emitted per dug grid
+        bool packed = false;                                // PuzzleCorpus packed records instead of text
+        bool archive = false;                               // a PuzzleArchive with solutions, written at the end
+        std::uint32_t seed = 0;                             // 0 draws one from random_device
+    };
+
+    struct StageReport {
+        unsigned threads = 0;
+        std::uint64_t items = 0;            // items this stage finished
+        double busy_seconds = 0.0;          // summed over the stage's threads, waits excluded
+        std::uint64_t full_waits = 0;       // pushes that found the next queue full
+        std::uint64_t empty_waits = 0;      // pops that found the input queue empty
+    };
+
+    struct QueueReport {
+        std::size_t capacity = 0;
+        double mean = 0.0;                  // sampled occupancy while the pipeline ran
+        std::size_t max = 0;
+    };
+
+    struct Report {
+        std::size_t written = 0;
+        std::size_t duplicates = 0;                         // repeats dropped by the output stage
+        std::array<std::size_t, 3> ratings{};               // written puzzles per rated Difficulty
+        double seconds = 0.0;
+        std::array<StageReport, STAGES> stages{};
+        std::array<QueueReport, STAGES - 1> queues{};       // queues[i] feeds stage i + 1
+    };
+
+    explicit GenerateCommand(Options options) noexcept;
+
+    Report run(std::ostream& out);
+
+    // Easy: singles alone solve it; Medium: pointing/claiming needed; Hard: needs guessing.
+    static Difficulty rate(const Grid& puzzle) noexcept;
+
+    static std::array<unsigned, STAGES> defaultThreads() noexcept;
+    static void printReport(const Report& report, std::ostream& out);
+
+    // Entry point for `sudoku generate COUNT [-o FILE] [-d easy|medium|hard] [--packed|--archive]
+    // [--variants N] [--fill N] [--dig N] [--rate N] [--queue N] [--seed N]`; args start at the mode name.
+    static int main(int argc, char** argv);
+
+private:
+    Options options_;
+};
+
+#endif // GENERATE_COMMAND_HPP
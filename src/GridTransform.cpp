@@ -0,0 +1,69 @@
+#include "GridTransform.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+using Lines = std::array<std::uint8_t, GridTransform::SIZE>;
+
+// shuffle the band order, then the lines inside every band
+Lines randomLines(std::mt19937& rng) noexcept {
+    constexpr int BOX = GridTransform::BOX;
+    std::array<std::uint8_t, BOX> bands{};
+    std::iota(bands.begin(), bands.end(), 0);
+    std::shuffle(bands.begin(), bands.end(), rng);
+    Lines lines{};
+    for (int band = 0; band < BOX; ++band) {
+        std::array<std::uint8_t, BOX> inner{};
+        std::iota(inner.begin(), inner.end(), 0);
+        std::shuffle(inner.begin(), inner.end(), rng);
+        for (int i = 0; i < BOX; ++i) {
+            lines[band * BOX + i] = static_cast<std::uint8_t>(bands[band] * BOX + inner[i]);
+        }
+    }
+    return lines;
+}
+
+} // namespace
+
+GridTransform::GridTransform() noexcept {
+    std::iota(source_.begin(), source_.end(), 0);
+    std::iota(digits_.begin(), digits_.end(), 0);
+}
+
+GridTransform GridTransform::random(std::mt19937& rng) noexcept {
+    std::array<std::uint8_t, SIZE + 1> digits{};
+    std::iota(digits.begin(), digits.end(), 0);
+    std::shuffle(digits.begin() + 1, digits.end(), rng);
+    Lines rows = randomLines(rng);
+    Lines cols = randomLines(rng);
+    bool transpose = (rng() & 1u) != 0;
+    return fromParts(rows, cols, transpose, digits);
+}
+
+GridTransform GridTransform::fromParts(const std::array<std::uint8_t, SIZE>& rows, const std::array<std::uint8_t, SIZE>& cols,
+                                       bool transpose, const std::array<std::uint8_t, SIZE + 1>& digits) noexcept {
+    GridTransform transform;
+    transform.digits_ = digits;
+    for (int row = 0; row < SIZE; ++row) {
+        for (int col = 0; col < SIZE; ++col) {
+            // permute first, then transpose: output (row, col) reads the permuted grid at (col, row)
+            int r = transpose ? col : row;
+            int c = transpose ? row : col;
+            transform.source_[row * SIZE + col] = static_cast<std::uint8_t>(rows[r] * SIZE + cols[c]);
+        }
+    }
+    return transform;
+}
+
+void GridTransform::apply(const Grid& in, Grid& out) const noexcept {
+    for (int cell = 0; cell < CELLS; ++cell) {
+        out[cell] = digits_[in[source_[cell]]];
+    }
+}
+
+GridTransform::Grid GridTransform::apply(const Grid& in) const noexcept {
+    Grid out;
+    apply(in, out);
+    return out;
+}
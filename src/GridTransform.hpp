@@ -0,0 +1,44 @@
+#ifndef GRID_TRANSFORM_HPP
+#define GRID_TRANSFORM_HPP
+
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+
+// One element of the 9x9 Sudoku symmetry group: relabel the digits, permute rows within
+// bands and the bands themselves, the same for columns and stacks, and optionally transpose.
+// Each of these maps valid grids to valid grids and unique puzzles to unique puzzles, so one
+// solved grid and its clue pattern yield millions of distinct-looking puzzles at the cost of
+// a table lookup per cell. Blanks stay blank, so applying a transform to a puzzle and to its
+// solution keeps the two matched.
+class GridTransform {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    static constexpr int SIZE = SudokuBoard::SIZE;
+    static constexpr int CELLS = SudokuBoard::CELLS;
+    static constexpr int BOX = SudokuBoard::BOX_ROWS;   // bands and stacks are BOX lines wide
+
+    GridTransform() noexcept;                           // identity
+    static GridTransform random(std::mt19937& rng) noexcept;
+
+    // Build from explicit parts: rows[r] / cols[c] name the source line for output line r / c
+    // and must keep bands (stacks) together; digits[v] is the new label of digit v (digits[0] = 0).
+    static GridTransform fromParts(const std::array<std::uint8_t, SIZE>& rows, const std::array<std::uint8_t, SIZE>& cols,
+                                   bool transpose, const std::array<std::uint8_t, SIZE + 1>& digits) noexcept;
+
+    void apply(const Grid& in, Grid& out) const noexcept;      // in and out must not alias
+    Grid apply(const Grid& in) const noexcept;
+
+    int sourceCell(int cell) const noexcept { return source_[cell]; }   // cell of the input that lands on cell
+    int mapDigit(int value) const noexcept { return digits_[value]; }
+
+private:
+    std::array<std::uint8_t, CELLS> source_{};          // output cell -> input cell
+    std::array<std::uint8_t, SIZE + 1> digits_{};       // input digit -> output digit, 0 -> 0
+};
+
+static_assert(SudokuBoard::BOX_ROWS == SudokuBoard::BOX_COLS, "transposition needs square boxes");
+
+#endif // GRID_TRANSFORM_HPP
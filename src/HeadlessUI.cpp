@@ -0,0 +1,145 @@
+#include "HeadlessUI.hpp"
+#include <ncurses.h>    // key codes only, no terminal is opened
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+namespace {
+
+struct KeyName {
+    std::string_view name;
+    int key;
+};
+
+// whitespace separates tokens and '#' starts a comment, so those keys need names too
+constexpr std::array<KeyName, 13> KEY_NAMES = {{
+    {"UP", KEY_UP}, {"DOWN", KEY_DOWN}, {"LEFT", KEY_LEFT}, {"RIGHT", KEY_RIGHT},
+    {"TAB", '\t'}, {"ENTER", '\n'}, {"ESC", 27}, {"BACKSPACE", KEY_BACKSPACE}, {"KEY_ENTER", KEY_ENTER},
+    {"SPACE", ' '}, {"HASH", '#'}, {"DELETE", KEY_DC}, {"ERR", ERR},
+}};
+
+// any other code in [0, KEY_MAX] is written as a backslash and its decimal value, e.g. \127
+constexpr char ESCAPE = '\\';
+
+bool isSpace(char ch) noexcept {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+} // namespace
+
+HeadlessUI::HeadlessUI(const SudokuBoard& board) noexcept : board_(board) {}
+
+void HeadlessUI::setKeys(std::vector<int> keys) noexcept {
+    keys_ = std::move(keys);
+    next_key_ = 0;
+}
+
+void HeadlessUI::displayBoard() const noexcept {
+    ++counters_.frames;
+    for (int row = 0; row < SudokuBoard::SIZE; ++row) {
+        for (int col = 0; col < SudokuBoard::SIZE; ++col) {
+            const int cell = row * SudokuBoard::SIZE + col;
+            const int value = board_.getCell(row, col);
+            frame_.cells[cell] = value == 0 ? '.' : static_cast<char>('0' + value);
+            frame_.errors[cell] = show_errors_ && board_.isInConflict(row, col);
+        }
+    }
+    frame_.cursor_row = cursor_row_;
+    frame_.cursor_col = cursor_col_;
+    frame_.focus = focus_;
+    frame_.selected_item = selected_menu_item_;
+    frame_.working = working_;
+}
+
+int HeadlessUI::getPressedKey() const noexcept {
+    return next_key_ < keys_.size() ? keys_[next_key_++] : ERR;
+}
+
+void HeadlessUI::displayMessage(const std::string& message) const noexcept {
+    ++counters_.messages;
+    last_message_ = message;
+}
+
+void HeadlessUI::flashScreen() const noexcept {
+    ++counters_.flashes;
+}
+
+void HeadlessUI::displayDifficultyMenu(int) const noexcept {
+    ++counters_.difficulty_menus;
+}
+
+void HeadlessUI::setCursorPosition(int row, int col) noexcept {
+    cursor_row_ = row;
+    cursor_col_ = col;
+}
+
+std::string HeadlessUI::Frame::text() const {
+    std::string out;
+    out.reserve(cells.size() + SudokuBoard::SIZE);
+    for (int row = 0; row < SudokuBoard::SIZE; ++row) {
+        out.append(cells.data() + row * SudokuBoard::SIZE, SudokuBoard::SIZE);
+        out.push_back('\n');
+    }
+    return out;
+}
+
+bool HeadlessUI::parseKeys(std::string_view text, std::vector<int>& keys) {
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        if (isSpace(text[pos])) {
+            ++pos;
+            continue;
+        }
+        std::size_t end = pos;
+        while (end < text.size() && !isSpace(text[end])) ++end;
+        const std::string_view token = text.substr(pos, end - pos);
+        if (token[0] == '#') {                      // comment to the end of the line
+            pos = text.find('\n', pos);
+            if (pos == std::string_view::npos) break;
+            continue;
+        }
+        pos = end;
+        if (token.size() == 1) {
+            keys.push_back(static_cast<unsigned char>(token[0]));
+            continue;
+        }
+        if (token[0] == ESCAPE) {
+            int key = 0;
+            const char* last = token.data() + token.size();
+            auto [ptr, ec] = std::from_chars(token.data() + 1, last, key);
+            if (ec != std::errc() || ptr != last || key < 0 || key > KEY_MAX) return false;
+            keys.push_back(key);
+            continue;
+        }
+        bool known = false;
+        for (const KeyName& entry : KEY_NAMES) {
+            if (entry.name == token) {
+                keys.push_back(entry.key);
+                known = true;
+                break;
+            }
+        }
+        if (!known) return false;
+    }
+    return true;
+}
+
+std::optional<std::string> HeadlessUI::formatKeys(std::span<const int> keys) {
+    std::string out;
+    for (int key : keys) {
+        if (!out.empty()) out.push_back(' ');
+        auto named = std::find_if(KEY_NAMES.begin(), KEY_NAMES.end(),
+                                  [key](const KeyName& entry) { return entry.key == key; });
+        if (named != KEY_NAMES.end()) {
+            out.append(named->name);
+        } else if (key > ' ' && key < 127) {
+            out.push_back(static_cast<char>(key));      // printable ASCII stands for itself
+        } else if (key >= 0 && key <= KEY_MAX) {
+            out.push_back(ESCAPE);
+            out.append(std::to_string(key));
+        } else {
+            return std::nullopt;                        // no key a terminal can deliver
+        }
+    }
+    return out;
+}
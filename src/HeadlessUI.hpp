@@ -0,0 +1,91 @@
+#ifndef HEADLESS_UI_HPP
+#define HEADLESS_UI_HPP
+
+#include "IGameUI.hpp"
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// IGameUI without a terminal, for driving GameController from tests and benchmarks. Keys come
+// from a script and every display call lands in memory: displayBoard renders the board and the
+// cursor, menu and working state into a Frame, messages and flashes are kept and counted.
+// Key scripts are text, one whitespace-separated token per key: a printable character stands
+// for itself, UP DOWN LEFT RIGHT TAB ENTER ESC BACKSPACE name the rest, '#' comments to the end
+// of the line.
+class HeadlessUI : public IGameUI {
+public:
+    struct Frame {
+        std::array<char, SudokuBoard::CELLS> cells{};   // '.' for empty, '1'..'9' otherwise
+        std::array<bool, SudokuBoard::CELLS> errors{};  // highlighted as a mistake
+        int cursor_row = 0;
+        int cursor_col = 0;
+        FocusState focus = FocusState::BOARD;
+        int selected_item = 0;
+        std::string working;                            // background task shown, empty when idle
+
+        std::string text() const;                       // the cells as SIZE lines
+    };
+
+    struct Counters {
+        std::size_t frames = 0;             // displayBoard calls
+        std::size_t messages = 0;
+        std::size_t flashes = 0;
+        std::size_t difficulty_menus = 0;
+    };
+
+    explicit HeadlessUI(const SudokuBoard& board) noexcept;
+
+    void setKeys(std::vector<int> keys) noexcept;       // replaces the script; getPressedKey pops from it
+    bool hasKeys() const noexcept { return next_key_ < keys_.size(); }
+
+    // --- IGameUI Interface Implementations ---
+    void displayBoard() const noexcept override;
+    int getPressedKey() const noexcept override;        // ERR once the script is used up
+    void displayMessage(const std::string& message) const noexcept override;
+    void flashScreen() const noexcept override;
+    void displayDifficultyMenu(int selected_difficulty) const noexcept override;
+
+    void setFocus(FocusState new_focus) noexcept override { focus_ = new_focus; }
+    void setCursorPosition(int row, int col) noexcept override;
+    void setSelectedMenuItem(int item) noexcept override { selected_menu_item_ = item; }
+    void showErrors(bool show) noexcept override { show_errors_ = show; }
+    void showWorking(const std::string& task) noexcept override { working_ = task; }
+
+    std::pair<int, int> getCursorPosition() const noexcept override { return {cursor_row_, cursor_col_}; }
+    FocusState getFocus() const noexcept override { return focus_; }
+    const std::vector<std::string>& getMenuItems() const noexcept override { return menu_items_; }
+    int getSelectedMenuItem() const noexcept override { return selected_menu_item_; }
+
+    const Frame& getFrame() const noexcept { return frame_; }         // as of the last displayBoard
+    const Counters& getCounters() const noexcept { return counters_; }
+    const std::string& getLastMessage() const noexcept { return last_message_; }
+
+    // Key script text <-> key codes; parseKeys stops at the first unknown token and returns false.
+    // formatKeys output parses back to the same keys; nullopt if a code is outside ERR..KEY_MAX.
+    static bool parseKeys(std::string_view text, std::vector<int>& keys);
+    static std::optional<std::string> formatKeys(std::span<const int> keys);
+
+private:
+    const SudokuBoard& board_;
+    std::vector<int> keys_;
+    mutable std::size_t next_key_ = 0;
+
+    int cursor_row_ = 0;
+    int cursor_col_ = 0;
+    FocusState focus_ = FocusState::BOARD;
+    int selected_menu_item_ = 0;
+    bool show_errors_ = false;
+    std::string working_;
+    const std::vector<std::string> menu_items_ = {"Submit", "Undo", "Hint", "New Game", "Quit"};   // as GameUI
+
+    mutable Frame frame_;
+    mutable Counters counters_;
+    mutable std::string last_message_;
+};
+
+#endif // HEADLESS_UI_HPP
@@ -23,7 +23,10 @@ public:
     virtual void setFocus(FocusState new_focus) noexcept = 0;
     virtual void setCursorPosition(int row, int col) noexcept = 0;
     virtual void setSelectedMenuItem(int item) noexcept = 0;
-    virtual void setErrors(const std::vector<std::pair<int, int>>& errors) noexcept = 0;
+    virtual void showErrors(bool show) noexcept = 0;     // highlight the board's conflicting cells
+    // name of the background task in progress, empty when idle; while one runs getPressedKey
+    // should return ERR after a short wait so the controller can poll the task
+    virtual void showWorking(const std::string& task) noexcept = 0;
 
     // --- State Getters (needed by GameController) ---
     virtual std::pair<int, int> getCursorPosition() const noexcept = 0;
@@ -0,0 +1,215 @@
+#include "ParallelSolver.hpp"
+#include "SearchSolver.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+bool isComplete(const SudokuBoard::Grid& grid) noexcept {
+    return std::find(grid.begin(), grid.end(), 0) == grid.end();
+}
+
+} // namespace
+
+ParallelSolver::ParallelSolver(unsigned threads) {
+    threads = std::max(threads, 1u);
+    // enough levels that every worker has a few dozen subtrees to steal from
+    split_depth_ = 1 + std::bit_width(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread(&ParallelSolver::workerLoop, this, i);
+    }
+}
+
+ParallelSolver::~ParallelSolver() {
+    {
+        std::lock_guard<std::mutex> lock(job_mutex_);
+        shutdown_ = true;
+    }
+    job_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+ParallelSolver& ParallelSolver::shared() {
+    static ParallelSolver pool;
+    return pool;
+}
+
+ParallelSolver::ParallelStats ParallelSolver::getStats() const noexcept {
+    return {tasks_run_.load(), splits_.load(), steals_.load()};
+}
+
+bool ParallelSolver::solve(Grid& grid, std::mt19937* rng) noexcept {
+    std::lock_guard<std::mutex> run(run_mutex_);
+    runJob(grid, Mode::Solve, 1, rng);
+    if (!found_) return false;
+    grid = result_;
+    return true;
+}
+
+int ParallelSolver::countSolutions(const Grid& grid, int limit) noexcept {
+    if (limit <= 0) return 0;
+    std::lock_guard<std::mutex> run(run_mutex_);
+    runJob(grid, Mode::Count, limit, nullptr);
+    return std::min(solutions_.load(), limit);
+}
+
+void ParallelSolver::runJob(const Grid& grid, Mode mode, int limit, std::mt19937* rng) noexcept {
+    mode_ = mode;
+    limit_ = limit;
+    seed_ = rng ? static_cast<std::uint32_t>((*rng)()) : 0;
+    stop_ = false;
+    solutions_ = 0;
+    found_ = false;
+    tasks_run_ = 0;
+    splits_ = 0;
+    steals_ = 0;
+
+    // the root is split on the calling thread so the caller's rng decides the top-level order
+    std::array<Grid, SudokuBoard::SIZE> children;
+    int count = root_solver_.split(grid, children);
+    if (count == 0) return;
+    if (count == 1 && isComplete(children[0])) {
+        recordSolution(children[0]);
+        return;
+    }
+    if (rng) {
+        std::shuffle(children.begin(), children.begin() + count, *rng);
+    }
+
+    pending_ = count;
+    for (int i = 0; i < count; ++i) {
+        push(static_cast<unsigned>(i) % getThreadCount(), {children[i], 1});
+    }
+    std::unique_lock<std::mutex> lock(job_mutex_);
+    ++job_id_;
+    job_cv_.notify_all();
+    done_cv_.wait(lock, [this] { return pending_.load() == 0; });
+}
+
+void ParallelSolver::workerLoop(unsigned index) noexcept {
+    SearchSolver& solver = workers_[index]->solver;
+    solver.setCancelFlag(&stop_);
+    std::uint64_t seen_job = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(job_mutex_);
+            job_cv_.wait(lock, [&] { return shutdown_ || job_id_ != seen_job; });
+            if (shutdown_) return;
+            seen_job = job_id_;
+        }
+        std::mt19937 rng(seed_ + index);
+        Task task;
+        while (pending_.load() > 0) {
+            if (!popOrSteal(index, task)) {
+                std::this_thread::yield();
+                continue;
+            }
+            runTask(index, task, solver, rng);
+            finishTask();
+        }
+    }
+}
+
+void ParallelSolver::runTask(unsigned index, const Task& task, SearchSolver& solver, std::mt19937& rng) noexcept {
+    ++tasks_run_;
+    if (stop_.load(std::memory_order_relaxed)) return;     // drain cancelled work
+
+    if (task.depth < split_depth_) {
+        std::array<Grid, SudokuBoard::SIZE> children;
+        int count = solver.split(task.grid, children);
+        ++splits_;
+        if (count == 1 && isComplete(children[0])) {
+            recordSolution(children[0]);
+            return;
+        }
+        pending_ += count;
+        for (int i = 0; i < count; ++i) {
+            const Task child{children[i], task.depth + 1};
+            if (!push(index, child)) {
+                searchTask(child, solver, rng);
+                finishTask();
+            }
+        }
+        return;
+    }
+    searchTask(task, solver, rng);
+}
+
+void ParallelSolver::searchTask(const Task& task, SearchSolver& solver, std::mt19937& rng) noexcept {
+    if (stop_.load(std::memory_order_relaxed)) return;
+    if (mode_ == Mode::Solve) {
+        Grid grid = task.grid;
+        if (solver.solve(grid, seed_ ? &rng : nullptr)) {
+            recordSolution(grid);
+        }
+    } else {
+        int remaining = limit_ - solutions_.load();
+        if (remaining <= 0) {
+            stop_ = true;
+            return;
+        }
+        int found = solver.countSolutions(task.grid, remaining);
+        if (solutions_.fetch_add(found) + found >= limit_) {
+            stop_ = true;
+        }
+    }
+}
+
+void ParallelSolver::recordSolution(const Grid& grid) noexcept {
+    if (mode_ == Mode::Count) {
+        if (solutions_.fetch_add(1) + 1 >= limit_) stop_ = true;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    if (!found_) {
+        found_ = true;
+        result_ = grid;
+    }
+    stop_ = true;
+}
+
+bool ParallelSolver::popOrSteal(unsigned index, Task& task) noexcept {
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.count != 0) {
+            --own.count;                    // newest first keeps the owner deep in its own subtree
+            task = own.tasks[(own.head + own.count) & (TASK_CAPACITY - 1)];
+            return true;
+        }
+    }
+    const unsigned count = getThreadCount();
+    for (unsigned k = 1; k < count; ++k) {
+        Worker& victim = *workers_[(index + k) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.count != 0) {
+            task = victim.tasks[victim.head];   // oldest task is the biggest subtree
+            victim.head = (victim.head + 1) & (TASK_CAPACITY - 1);
+            --victim.count;
+            ++steals_;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParallelSolver::push(unsigned index, const Task& task) noexcept {
+    Worker& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.count == TASK_CAPACITY) return false;
+    worker.tasks[(worker.head + worker.count) & (TASK_CAPACITY - 1)] = task;
+    ++worker.count;
+    return true;
+}
+
+void ParallelSolver::finishTask() noexcept {
+    if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(job_mutex_);
+        done_cv_.notify_all();
+    }
+}
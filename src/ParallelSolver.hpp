@@ -0,0 +1,99 @@
+#ifndef PARALLEL_SOLVER_HPP
+#define PARALLEL_SOLVER_HPP
+
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Parallel search for a single puzzle. The search tree is split into subtree tasks down to
+// a shallow depth; tasks live in per-worker deques, owners pop from the back and idle workers
+// steal from the front. In solve mode the first solution cancels every other task, in
+// counting mode the workers add up their counts until the limit is reached. The deques are
+// fixed rings allocated with the pool, so a job allocates nothing; a split that finds its
+// ring full searches the child in place instead of queueing it.
+class ParallelSolver {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    struct ParallelStats {
+        std::uint64_t tasks = 0;        // subtrees processed
+        std::uint64_t splits = 0;       // tasks that were split instead of searched
+        std::uint64_t steals = 0;       // tasks taken from another worker's deque
+    };
+
+    explicit ParallelSolver(unsigned threads = std::thread::hardware_concurrency());
+    ~ParallelSolver();
+    ParallelSolver(const ParallelSolver&) = delete;
+    ParallelSolver& operator=(const ParallelSolver&) = delete;
+
+    static ParallelSolver& shared();            // process-wide pool sized to the machine
+
+    // Same contracts as SearchSolver::solve / countSolutions. One job runs at a time.
+    bool solve(Grid& grid, std::mt19937* rng = nullptr) noexcept;
+    int countSolutions(const Grid& grid, int limit) noexcept;
+
+    unsigned getThreadCount() const noexcept { return static_cast<unsigned>(workers_.size()); }
+    ParallelStats getStats() const noexcept;
+
+private:
+    enum class Mode { Solve, Count };
+
+    struct Task {
+        Grid grid;
+        int depth;
+    };
+
+    static constexpr std::size_t TASK_CAPACITY = 512;      // per worker, a power of two
+
+    struct Worker {
+        std::mutex mutex;
+        std::unique_ptr<Task[]> tasks = std::make_unique<Task[]>(TASK_CAPACITY);     // ring, oldest at head
+        std::size_t head = 0;
+        std::size_t count = 0;
+        SearchSolver solver;                    // built here, so the thread allocates nothing of its own
+        std::thread thread;
+    };
+
+    void runJob(const Grid& grid, Mode mode, int limit, std::mt19937* rng) noexcept;
+    void workerLoop(unsigned index) noexcept;
+    void runTask(unsigned index, const Task& task, SearchSolver& solver, std::mt19937& rng) noexcept;
+    bool popOrSteal(unsigned index, Task& task) noexcept;
+    bool push(unsigned index, const Task& task) noexcept;       // false if the worker's ring is full
+    void searchTask(const Task& task, SearchSolver& solver, std::mt19937& rng) noexcept;
+    void finishTask() noexcept;
+    void recordSolution(const Grid& grid) noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    SearchSolver root_solver_;                  // splits each job's root on the calling thread
+    int split_depth_ = 0;                       // tasks shallower than this are split further
+
+    // job state
+    std::mutex job_mutex_;
+    std::condition_variable job_cv_;            // wakes workers for a new job
+    std::condition_variable done_cv_;           // wakes the caller when pending_ hits zero
+    std::uint64_t job_id_ = 0;
+    bool shutdown_ = false;
+    std::mutex run_mutex_;                      // serializes callers
+    Mode mode_ = Mode::Solve;
+    int limit_ = 1;
+    std::uint32_t seed_ = 0;
+    std::atomic<std::int64_t> pending_{0};      // tasks queued or running
+    std::atomic<bool> stop_{false};
+    std::atomic<int> solutions_{0};
+    std::mutex result_mutex_;
+    bool found_ = false;
+    Grid result_{};
+
+    std::atomic<std::uint64_t> tasks_run_{0};
+    std::atomic<std::uint64_t> splits_{0};
+    std::atomic<std::uint64_t> steals_{0};
+};
+
+#endif // PARALLEL_SOLVER_HPP
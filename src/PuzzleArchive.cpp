@@ -0,0 +1,113 @@
+#include "PuzzleArchive.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+bool PuzzleArchive::open(const std::string& path) noexcept {
+    close();
+    if (!corpus_.open(path, PuzzleCorpus::Access::Random)) return false;
+    std::span<const char> bytes = corpus_.bytes();
+    if (corpus_.getFormat() == PuzzleCorpus::Format::Text || bytes.size() < PuzzleCorpus::ARCHIVE_HEADER_SIZE ||
+        std::memcmp(bytes.data(), PuzzleCorpus::ARCHIVE_MAGIC, sizeof(PuzzleCorpus::ARCHIVE_MAGIC)) != 0) {
+        close();
+        return false;
+    }
+
+    // the groups must tile the records exactly, in difficulty order
+    const std::size_t record_size = PuzzleCorpus::recordSize(corpus_.getFormat());
+    std::size_t expected = PuzzleCorpus::ARCHIVE_HEADER_SIZE;
+    for (int slot = 0; slot < DIFFICULTIES; ++slot) {
+        std::uint64_t offset = 0;
+        std::uint64_t count = 0;
+        std::memcpy(&offset, bytes.data() + 24 + 16 * slot, sizeof(offset));
+        std::memcpy(&count, bytes.data() + 32 + 16 * slot, sizeof(count));
+        if (offset != expected || count > (bytes.size() - expected) / record_size) {
+            close();
+            return false;
+        }
+        groups_[slot] = bytes.data() + offset;
+        counts_[slot] = static_cast<std::size_t>(count);
+        expected += static_cast<std::size_t>(count) * record_size;
+    }
+    record_size_ = record_size;
+    return true;
+}
+
+void PuzzleArchive::close() noexcept {
+    corpus_.close();
+    groups_ = {};
+    counts_ = {};
+    record_size_ = 0;
+}
+
+std::size_t PuzzleArchive::size() const noexcept {
+    return counts_[0] + counts_[1] + counts_[2];
+}
+
+bool PuzzleArchive::read(Difficulty difficulty, std::size_t position, Grid& givens, Grid* solution) const noexcept {
+    const int slot = index(difficulty);
+    if (position >= counts_[slot]) return false;
+    const auto* record = reinterpret_cast<const std::uint8_t*>(groups_[slot] + position * record_size_);
+    if (hasSolutions()) return PuzzleCorpus::unpackSolved(record, givens, solution);
+    return PuzzleCorpus::unpack(record, givens);
+}
+
+bool PuzzleArchive::read(std::size_t position, Difficulty& difficulty, Grid& givens, Grid* solution) const noexcept {
+    for (int slot = 0; slot < DIFFICULTIES; ++slot) {
+        if (position < counts_[slot]) {
+            difficulty = static_cast<Difficulty>(slot);
+            return read(difficulty, position, givens, solution);
+        }
+        position -= counts_[slot];
+    }
+    return false;
+}
+
+bool PuzzleArchive::write(std::ostream& out, std::span<const Entry> entries, bool with_solutions) {
+    const std::size_t record_size = with_solutions ? PuzzleCorpus::SOLVED_RECORD_SIZE : PuzzleCorpus::PACKED_RECORD_SIZE;
+    std::array<std::uint64_t, DIFFICULTIES> counts{};
+    for (const Entry& entry : entries) ++counts[index(entry.difficulty)];
+
+    char header[PuzzleCorpus::ARCHIVE_HEADER_SIZE] = {};
+    std::memcpy(header, PuzzleCorpus::ARCHIVE_MAGIC, sizeof(PuzzleCorpus::ARCHIVE_MAGIC));
+    const std::uint32_t version = PuzzleCorpus::ARCHIVE_VERSION;
+    const auto stored_size = static_cast<std::uint32_t>(record_size);
+    std::memcpy(header + 8, &version, sizeof(version));
+    std::memcpy(header + 12, &stored_size, sizeof(stored_size));
+    std::uint64_t offset = PuzzleCorpus::ARCHIVE_HEADER_SIZE;
+    for (int slot = 0; slot < DIFFICULTIES; ++slot) {
+        std::memcpy(header + 24 + 16 * slot, &offset, sizeof(offset));
+        std::memcpy(header + 32 + 16 * slot, &counts[slot], sizeof(counts[slot]));
+        offset += counts[slot] * record_size;
+    }
+    out.write(header, sizeof(header));
+
+    // one pass per difficulty keeps each group in input order without sorting a copy
+    std::vector<char> buffer;
+    buffer.reserve(std::min<std::size_t>(entries.size(), 1u << 16) * record_size);
+    for (int slot = 0; slot < DIFFICULTIES; ++slot) {
+        for (const Entry& entry : entries) {
+            if (index(entry.difficulty) != slot) continue;
+            std::size_t at = buffer.size();
+            buffer.resize(at + record_size);
+            auto* record = reinterpret_cast<std::uint8_t*>(buffer.data() + at);
+            if (with_solutions) {
+                PuzzleCorpus::packSolved(entry.givens, entry.solution, record);
+            } else {
+                PuzzleCorpus::pack(entry.givens, record);
+            }
+            if (buffer.size() + record_size > buffer.capacity()) {
+                out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(out);
+}
+
+bool PuzzleArchive::write(const std::string& path, std::span<const Entry> entries, bool with_solutions) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    return out && write(out, entries, with_solutions);
+}
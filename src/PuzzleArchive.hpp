@@ -0,0 +1,61 @@
+#ifndef PUZZLE_ARCHIVE_HPP
+#define PUZZLE_ARCHIVE_HPP
+
+#include "PuzzleCorpus.hpp"
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+
+// Versioned binary puzzle library with random access. Puzzles are grouped by Difficulty and
+// the header indexes the groups, so "puzzle i of Hard" is a multiply and an unpack out of the
+// memory map, with nothing parsed up front:
+//   header (72 bytes): "SUDOKUAR", uint32 version, uint32 record size, 8 reserved bytes, then
+//                      per Difficulty a uint64 file offset of its first record and a uint64 count
+//   records:           Easy, then Medium, then Hard, back to back
+// A record is either the packed givens (41 bytes) or, for archives with solutions, the packed
+// solution plus a bitmask of the given cells (52 bytes). PuzzleCorpus recognizes the header, so
+// `sudoku solve`, `validate` and `dedupe` read archives as they are.
+class PuzzleArchive {
+public:
+    using Grid = SudokuBoard::Grid;
+    using Difficulty = SudokuBoard::Difficulty;
+
+    static constexpr int DIFFICULTIES = 3;                  // Easy, Medium, Hard
+
+    struct Entry {
+        Difficulty difficulty = Difficulty::Easy;
+        Grid givens{};
+        Grid solution{};            // only written to archives with solutions
+    };
+
+    bool open(const std::string& path) noexcept;    // false unless it is a well-formed archive
+    void close() noexcept;
+
+    bool isOpen() const noexcept { return record_size_ != 0; }
+    bool hasSolutions() const noexcept { return record_size_ == PuzzleCorpus::SOLVED_RECORD_SIZE; }
+    std::size_t size() const noexcept;
+    std::size_t size(Difficulty difficulty) const noexcept { return counts_[index(difficulty)]; }
+
+    // Puzzle `position` of a difficulty, or of the whole archive in file order. solution is left
+    // untouched when the archive has none. False if position is out of range or the record is damaged.
+    bool read(Difficulty difficulty, std::size_t position, Grid& givens, Grid* solution = nullptr) const noexcept;
+    bool read(std::size_t position, Difficulty& difficulty, Grid& givens, Grid* solution = nullptr) const noexcept;
+
+    // Write entries grouped by difficulty, keeping their order within a group.
+    static bool write(std::ostream& out, std::span<const Entry> entries, bool with_solutions);
+    static bool write(const std::string& path, std::span<const Entry> entries, bool with_solutions);
+
+private:
+    static int index(Difficulty difficulty) noexcept { return static_cast<int>(difficulty); }
+
+    PuzzleCorpus corpus_;
+    std::array<const char*, DIFFICULTIES> groups_{};        // first record of each difficulty
+    std::array<std::size_t, DIFFICULTIES> counts_{};
+    std::size_t record_size_ = 0;                           // 0 while closed
+};
+
+#endif // PUZZLE_ARCHIVE_HPP
@@ -0,0 +1,201 @@
+#include "PuzzleCorpus.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+PuzzleCorpus::~PuzzleCorpus() {
+    close();
+}
+
+bool PuzzleCorpus::open(const std::string& path, Access access) noexcept {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    map_size_ = static_cast<std::size_t>(info.st_size);
+    if (map_size_ > 0) {
+        void* map = ::mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            ::close(fd);
+            map_size_ = 0;
+            return false;
+        }
+        // a scan reads once front to back, archive lookups jump around
+        ::madvise(map, map_size_, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        map_ = map;
+    }
+    ::close(fd);    // the mapping keeps the file alive
+
+    std::span<const char> data(static_cast<const char*>(map_), map_size_);
+    std::size_t header_size = 0;
+    if (!detectFormat(data, format_, header_size)) {
+        close();
+        return false;
+    }
+    records_ = data.subspan(header_size);
+    return true;
+}
+
+void PuzzleCorpus::close() noexcept {
+    if (map_) {
+        ::munmap(map_, map_size_);
+    }
+    map_ = nullptr;
+    map_size_ = 0;
+    format_ = Format::Text;
+    records_ = {};
+}
+
+bool PuzzleCorpus::detectFormat(std::span<const char> head, Format& format, std::size_t& header_size) noexcept {
+    format = Format::Text;
+    header_size = 0;
+    if (head.size() < sizeof(PACKED_MAGIC)) return true;
+    std::uint32_t version = 0;
+    std::uint32_t record_size = 0;
+    if (std::memcmp(head.data(), ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) == 0) {
+        if (head.size() < ARCHIVE_HEADER_SIZE) return false;
+        std::memcpy(&version, head.data() + 8, sizeof(version));
+        std::memcpy(&record_size, head.data() + 12, sizeof(record_size));
+        if (version != ARCHIVE_VERSION || (record_size != PACKED_RECORD_SIZE && record_size != SOLVED_RECORD_SIZE)) {
+            return false;
+        }
+        format = record_size == PACKED_RECORD_SIZE ? Format::Packed : Format::PackedSolved;
+        header_size = ARCHIVE_HEADER_SIZE;
+        return true;
+    }
+    if (std::memcmp(head.data(), PACKED_MAGIC, sizeof(PACKED_MAGIC)) != 0) return true;
+    if (head.size() < PACKED_HEADER_SIZE) return false;
+    std::memcpy(&version, head.data() + 8, sizeof(version));
+    std::memcpy(&record_size, head.data() + 12, sizeof(record_size));
+    if (version != PACKED_VERSION || record_size != PACKED_RECORD_SIZE) return false;
+    format = Format::Packed;
+    header_size = PACKED_HEADER_SIZE;
+    return true;
+}
+
+std::size_t PuzzleCorpus::recordBoundary(std::span<const char> data, std::size_t offset, Format format) noexcept {
+    if (offset >= data.size()) return data.size();
+    if (format != Format::Text) {
+        const std::size_t size = recordSize(format);
+        std::size_t rounded = (offset + size - 1) / size * size;
+        return std::min(rounded, data.size());
+    }
+    if (offset == 0) return 0;
+    // a boundary sits just past a newline; start looking at the byte before offset
+    const void* newline = std::memchr(data.data() + offset - 1, '\n', data.size() - offset + 1);
+    return newline ? static_cast<std::size_t>(static_cast<const char*>(newline) - data.data()) + 1 : data.size();
+}
+
+bool PuzzleCorpus::parseText(std::string_view line, Grid& grid) noexcept {
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+        line.remove_suffix(1);
+    }
+    if (line.size() != SudokuBoard::CELLS) return false;
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        char c = line[i];
+        if (c >= '1' && c <= '9') {
+            grid[i] = static_cast<std::uint8_t>(c - '0');
+        } else if (c == '.' || c == '0') {
+            grid[i] = 0;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PuzzleCorpus::pack(const Grid& grid, std::uint8_t* out) noexcept {
+    for (std::size_t i = 0; i < PACKED_RECORD_SIZE; ++i) {
+        std::uint8_t low = grid[2 * i];
+        std::uint8_t high = 2 * i + 1 < grid.size() ? grid[2 * i + 1] : 0;
+        out[i] = static_cast<std::uint8_t>(low | (high << 4));
+    }
+}
+
+bool PuzzleCorpus::unpack(const std::uint8_t* in, Grid& grid) noexcept {
+    bool ok = true;
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        std::uint8_t value = (in[i / 2] >> ((i & 1) * 4)) & 0xF;
+        ok = ok && value <= SudokuBoard::SIZE;
+        grid[i] = value <= SudokuBoard::SIZE ? value : 0;
+    }
+    return ok;
+}
+
+void PuzzleCorpus::packSolved(const Grid& givens, const Grid& solution, std::uint8_t* out) noexcept {
+    pack(solution, out);
+    std::uint8_t* mask = out + PACKED_RECORD_SIZE;
+    std::memset(mask, 0, GIVEN_MASK_SIZE);
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        if (givens[i] != 0) mask[i / 8] = static_cast<std::uint8_t>(mask[i / 8] | (1u << (i % 8)));
+    }
+}
+
+bool PuzzleCorpus::unpackSolved(const std::uint8_t* in, Grid& givens, Grid* solution) noexcept {
+    Grid full{};
+    bool ok = unpack(in, full);
+    const std::uint8_t* mask = in + PACKED_RECORD_SIZE;
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        ok = ok && full[i] != 0;
+        givens[i] = (mask[i / 8] >> (i % 8)) & 1 ? full[i] : 0;
+    }
+    if (solution) *solution = full;
+    return ok;
+}
+
+void PuzzleCorpus::writePackedHeader(std::ostream& out) {
+    char header[PACKED_HEADER_SIZE] = {};
+    std::memcpy(header, PACKED_MAGIC, sizeof(PACKED_MAGIC));
+    std::uint32_t version = PACKED_VERSION;
+    std::uint32_t record_size = PACKED_RECORD_SIZE;
+    std::memcpy(header + 8, &version, sizeof(version));
+    std::memcpy(header + 12, &record_size, sizeof(record_size));
+    out.write(header, sizeof(header));
+}
+
+bool PuzzleCorpus::readBlocks(std::istream& in, std::size_t buffer_bytes,
+                              const std::function<void(std::span<const char>, Format)>& visit) {
+    std::vector<char> buffer(buffer_bytes);
+    std::size_t filled = 0;
+    bool first = true;
+    Format format = Format::Text;
+    while (true) {
+        in.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+        filled += static_cast<std::size_t>(in.gcount());
+        const bool eof = !in;
+
+        std::span<const char> data(buffer.data(), filled);
+        std::size_t skip = 0;
+        if (first) {
+            if (!detectFormat(data, format, skip)) return false;     // unsupported packed header
+            first = false;
+        }
+        data = data.subspan(skip);
+        // whole records only, unless this is the tail of the input
+        std::size_t usable = data.size();
+        if (!eof) {
+            if (format != Format::Text) {
+                usable -= usable % recordSize(format);
+            } else {
+                auto newline = std::find(data.rbegin(), data.rend(), '\n');
+                usable = static_cast<std::size_t>(data.rend() - newline);
+            }
+            if (usable == 0 && filled == buffer.size()) usable = data.size();   // absurdly long line
+        }
+        visit(data.first(usable), format);
+
+        const std::size_t consumed = skip + usable;
+        std::copy(buffer.begin() + consumed, buffer.begin() + filled, buffer.begin());
+        filled -= consumed;
+        if (eof) return true;
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef PUZZLE_CORPUS_HPP
+#define PUZZLE_CORPUS_HPP
+
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Read-only view of a puzzle file. The file is memory-mapped, never copied, and records are
+// parsed straight out of the mapping into a caller-owned Grid, so scanning a corpus does no
+// per-record allocation. Three formats are understood:
+//   text:    one puzzle per line, 81 characters, '.' or '0' for blanks
+//   packed:  16-byte header, then 41 bytes per puzzle (two cells per byte, low nibble first)
+//   archive: PuzzleArchive's 72-byte header and difficulty index, then either packed puzzles
+//            or 52-byte records holding the packed solution and a bitmask of the given cells
+// Records of an archive are read in file order, so batch tools need not know about its index.
+class PuzzleCorpus {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    enum class Format { Text, Packed, PackedSolved };     // PackedSolved: archive records with solutions
+
+    static constexpr std::size_t PACKED_RECORD_SIZE = (SudokuBoard::CELLS + 1) / 2;    // 41
+    static constexpr std::size_t PACKED_HEADER_SIZE = 16;
+    static constexpr char PACKED_MAGIC[8] = {'S', 'U', 'D', 'O', 'K', 'U', 'P', 'K'};
+    static constexpr std::uint32_t PACKED_VERSION = 1;
+
+    static constexpr std::size_t GIVEN_MASK_SIZE = (SudokuBoard::CELLS + 7) / 8;                   // 11
+    static constexpr std::size_t SOLVED_RECORD_SIZE = PACKED_RECORD_SIZE + GIVEN_MASK_SIZE;         // 52
+    static constexpr std::size_t ARCHIVE_HEADER_SIZE = 72;
+    static constexpr char ARCHIVE_MAGIC[8] = {'S', 'U', 'D', 'O', 'K', 'U', 'A', 'R'};
+    static constexpr std::uint32_t ARCHIVE_VERSION = 1;
+
+    enum class Access { Sequential, Random };       // read-ahead hint for the mapping
+
+    PuzzleCorpus() noexcept = default;
+    ~PuzzleCorpus();
+    PuzzleCorpus(const PuzzleCorpus&) = delete;
+    PuzzleCorpus& operator=(const PuzzleCorpus&) = delete;
+
+    // map the whole file, false if it cannot be read
+    bool open(const std::string& path, Access access = Access::Sequential) noexcept;
+    void close() noexcept;
+
+    Format getFormat() const noexcept { return format_; }
+    std::span<const char> records() const noexcept { return records_; }    // header already skipped
+    std::span<const char> bytes() const noexcept { return {static_cast<const char*>(map_), map_size_}; }
+
+    // bytes per record of a binary format, 0 for text
+    static constexpr std::size_t recordSize(Format format) noexcept {
+        return format == Format::Packed ? PACKED_RECORD_SIZE : format == Format::PackedSolved ? SOLVED_RECORD_SIZE : 0;
+    }
+
+    // Format of a buffer that starts at the beginning of a file; a packed file is identified by
+    // its header. On success header_size receives the number of bytes to skip.
+    static bool detectFormat(std::span<const char> head, Format& format, std::size_t& header_size) noexcept;
+
+    // First record boundary at or after offset: just past a newline for text, a multiple of
+    // recordSize for the binary formats. Used to cut the file into per-thread chunks.
+    static std::size_t recordBoundary(std::span<const char> data, std::size_t offset, Format format) noexcept;
+
+    // Text line to grid; false (grid unspecified) if the length or a character is wrong.
+    // A trailing '\r' or spaces are ignored.
+    static bool parseText(std::string_view line, Grid& grid) noexcept;
+
+    static void pack(const Grid& grid, std::uint8_t* out) noexcept;            // writes PACKED_RECORD_SIZE bytes
+    static bool unpack(const std::uint8_t* in, Grid& grid) noexcept;           // false on a nibble above 9
+    // SOLVED_RECORD_SIZE bytes: the solution, then one bit per cell that is a given
+    static void packSolved(const Grid& givens, const Grid& solution, std::uint8_t* out) noexcept;
+    static bool unpackSolved(const std::uint8_t* in, Grid& givens, Grid* solution) noexcept;     // false unless the solution is full
+    static void writePackedHeader(std::ostream& out);
+
+    // Read a whole stream through a buffer of buffer_bytes and hand visit(region, format) whole
+    // records only; a record cut by the end of a read is carried into the next one. The format
+    // comes from the first read's header. False, with nothing visited, if that header is a
+    // packed one this build cannot read.
+    static bool readBlocks(std::istream& in, std::size_t buffer_bytes,
+                           const std::function<void(std::span<const char>, Format)>& visit);
+
+    // Call visit(grid, ok, raw) for every record in chunk, in order; raw is the line (text)
+    // or the record bytes (binary), ok is false for a malformed record. Blank lines are skipped.
+    template <typename Visit>
+    static void forEachRecord(std::span<const char> chunk, Format format, Visit&& visit) noexcept {
+        Grid grid{};
+        const char* pos = chunk.data();
+        const char* end = pos + chunk.size();
+        if (format != Format::Text) {
+            const std::size_t size = recordSize(format);
+            for (; pos + size <= end; pos += size) {
+                const auto* record = reinterpret_cast<const std::uint8_t*>(pos);
+                bool ok = format == Format::Packed ? unpack(record, grid) : unpackSolved(record, grid, nullptr);
+                visit(grid, ok, std::string_view(pos, size));
+            }
+            return;
+        }
+        while (pos < end) {
+            const char* newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+            const char* line_end = newline ? newline : end;
+            std::string_view line(pos, static_cast<std::size_t>(line_end - pos));
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.find_first_not_of(" \t") != std::string_view::npos) {
+                bool ok = parseText(line, grid);
+                visit(grid, ok, line);
+            }
+            pos = line_end + 1;
+        }
+    }
+
+private:
+    void* map_ = nullptr;
+    std::size_t map_size_ = 0;
+    Format format_ = Format::Text;
+    std::span<const char> records_{};
+};
+
+#endif // PUZZLE_CORPUS_HPP
@@ -0,0 +1,180 @@
+#include "PuzzlePool.hpp"
+#include "SearchSolver.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+// an archive puzzle with its solution, solving it when the archive stores none
+bool readPuzzle(const PuzzleArchive& archive, SudokuBoard::Difficulty difficulty, std::size_t position,
+                PuzzlePool::Puzzle& puzzle) noexcept {
+    if (!archive.read(difficulty, position, puzzle.givens, &puzzle.solution)) return false;
+    if (archive.hasSolutions()) return true;
+    puzzle.solution = puzzle.givens;
+    thread_local SearchSolver solver;
+    return solver.solve(puzzle.solution);
+}
+
+} // namespace
+
+PuzzlePool::PuzzlePool() noexcept : PuzzlePool(Watermarks{}) {}
+
+PuzzlePool::PuzzlePool(Watermarks marks) noexcept : marks_(marks) {
+    marks_.high = std::max(marks_.high, marks_.low);
+    for (int slot = 0; slot < DIFFICULTIES; ++slot) {
+        puzzles_[slot].reserve(marks_.high);
+        updateRefill(slot);
+    }
+}
+
+PuzzlePool::~PuzzlePool() {
+    stop();
+}
+
+void PuzzlePool::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (thread_.joinable()) return;
+    stopping_ = false;
+    thread_ = std::thread([this] { refillLoop(); });
+}
+
+void PuzzlePool::stop() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    refill_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void PuzzlePool::take(Difficulty difficulty, SudokuBoard& board) noexcept {
+    Puzzle puzzle;
+    if (tryTake(difficulty, puzzle)) {
+        board.loadPuzzle(puzzle.givens, &puzzle.solution);
+    } else if (archive_.size(difficulty) > 0) {
+        puzzle = nextPuzzle(difficulty);    // pool ran dry, the refill thread is already woken
+        board.loadPuzzle(puzzle.givens, &puzzle.solution);
+    } else {
+        board.generatePuzzle(difficulty);
+    }
+}
+
+bool PuzzlePool::tryTake(Difficulty difficulty, Puzzle& puzzle) noexcept {
+    const int slot = index(difficulty);
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& stock = puzzles_[slot];
+        if (!stock.empty()) {
+            puzzle = stock.back();
+            stock.pop_back();
+            found = true;
+        }
+        updateRefill(slot);
+    }
+    refill_cv_.notify_one();
+    return found;
+}
+
+void PuzzlePool::add(Difficulty difficulty, const Puzzle& puzzle) noexcept {
+    const int slot = index(difficulty);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (puzzles_[slot].size() < marks_.high) {
+        puzzles_[slot].push_back(puzzle);
+    }
+    updateRefill(slot);
+}
+
+std::size_t PuzzlePool::size(Difficulty difficulty) const noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return puzzles_[index(difficulty)].size();
+}
+
+void PuzzlePool::updateRefill(int slot) noexcept {
+    std::size_t count = puzzles_[slot].size();
+    if (count < marks_.low) {
+        refilling_[slot] = true;
+    } else if (count >= marks_.high) {
+        refilling_[slot] = false;
+    }
+}
+
+void PuzzlePool::refillLoop() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        // the emptiest difficulty that is still refilling goes first
+        int slot = -1;
+        for (int s = 0; s < DIFFICULTIES; ++s) {
+            if (refilling_[s] && (slot < 0 || puzzles_[s].size() < puzzles_[slot].size())) slot = s;
+        }
+        if (stopping_) return;
+        if (slot < 0) {
+            refill_cv_.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        Puzzle puzzle = nextPuzzle(static_cast<Difficulty>(slot));
+        lock.lock();
+        if (puzzles_[slot].size() < marks_.high) {
+            puzzles_[slot].push_back(puzzle);
+        }
+        updateRefill(slot);
+    }
+}
+
+PuzzlePool::Puzzle PuzzlePool::generate(Difficulty difficulty) noexcept {
+    Puzzle puzzle;
+    SudokuBoard board;
+    board.generatePuzzle(difficulty);
+    std::copy(board.getBoard().begin(), board.getBoard().end(), puzzle.givens.begin());
+    auto solution = board.getSolution();       // generatePuzzle keeps the grid it dug the puzzle from
+    std::copy(solution->begin(), solution->end(), puzzle.solution.begin());
+    return puzzle;
+}
+
+PuzzlePool::Puzzle PuzzlePool::nextPuzzle(Difficulty difficulty) noexcept {
+    const std::size_t count = archive_.size(difficulty);
+    if (count == 0) return generate(difficulty);
+    std::mt19937 rng(std::random_device{}());
+    Puzzle puzzle;
+    const std::size_t position = std::uniform_int_distribution<std::size_t>(0, count - 1)(rng);
+    return readPuzzle(archive_, difficulty, position, puzzle) ? puzzle : generate(difficulty);
+}
+
+bool PuzzlePool::useArchive(const std::string& path) noexcept {
+    return archive_.open(path);
+}
+
+bool PuzzlePool::save(const std::string& path) const noexcept {
+    std::vector<PuzzleArchive::Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int slot = 0; slot < DIFFICULTIES; ++slot) {
+            for (const Puzzle& puzzle : puzzles_[slot]) {
+                entries.push_back({static_cast<Difficulty>(slot), puzzle.givens, puzzle.solution});
+            }
+        }
+    }
+    return PuzzleArchive::write(path, entries, true);
+}
+
+bool PuzzlePool::load(const std::string& path) noexcept {
+    PuzzleArchive archive;
+    if (!archive.open(path)) return false;
+    for (int slot = 0; slot < DIFFICULTIES; ++slot) {
+        const auto difficulty = static_cast<Difficulty>(slot);
+        // no point unpacking more than the pool keeps
+        for (std::size_t i = 0; i < archive.size(difficulty) && size(difficulty) < marks_.high; ++i) {
+            Puzzle puzzle;
+            if (readPuzzle(archive, difficulty, i, puzzle)) add(difficulty, puzzle);     // skip a damaged record
+        }
+    }
+    return true;
+}
+
+std::string PuzzlePool::defaultPath() {
+    const char* home = std::getenv("HOME");
+    return home && *home ? std::string(home) + "/.sudoku_pool" : std::string(".sudoku_pool");
+}
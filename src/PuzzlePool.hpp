@@ -0,0 +1,80 @@
+#ifndef PUZZLE_POOL_HPP
+#define PUZZLE_POOL_HPP
+
+#include "PuzzleArchive.hpp"
+#include "SudokuBoard.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Ready-made puzzles for each Difficulty, so starting a game is a pop instead of a generation.
+// A background thread refills a difficulty once it drops below the low watermark and keeps
+// going until it reaches the high one. Puzzles are stored with their solution so the board's
+// hint cache is warm from the first move. save/load keep the pool across runs as a
+// PuzzleArchive, and useArchive makes refills draw from a prepared library instead of generating.
+class PuzzlePool {
+public:
+    using Grid = SudokuBoard::Grid;
+    using Difficulty = SudokuBoard::Difficulty;
+
+    static constexpr int DIFFICULTIES = 3;                  // Easy, Medium, Hard
+
+    struct Puzzle {
+        Grid givens{};
+        Grid solution{};
+    };
+
+    struct Watermarks {
+        std::size_t low = 2;        // refill starts below this many puzzles
+        std::size_t high = 6;       // and stops at this many
+    };
+
+    PuzzlePool() noexcept;                          // default watermarks
+    explicit PuzzlePool(Watermarks marks) noexcept;
+    ~PuzzlePool();                                  // stops the refill thread
+    PuzzlePool(const PuzzlePool&) = delete;
+    PuzzlePool& operator=(const PuzzlePool&) = delete;
+
+    void start();                                   // launch the refill thread
+    void stop() noexcept;                           // finish the puzzle in progress and join
+
+    // Pop a puzzle into board. An empty pool generates on the caller's thread instead.
+    void take(Difficulty difficulty, SudokuBoard& board) noexcept;
+    bool tryTake(Difficulty difficulty, Puzzle& puzzle) noexcept;   // false if none is ready
+    void add(Difficulty difficulty, const Puzzle& puzzle) noexcept; // dropped once the high watermark is reached
+
+    std::size_t size(Difficulty difficulty) const noexcept;
+    Watermarks getWatermarks() const noexcept { return marks_; }
+
+    bool save(const std::string& path) const noexcept;     // an archive with solutions
+    bool load(const std::string& path) noexcept;    // appends any archive's puzzles, false if unreadable
+    static std::string defaultPath();               // $HOME/.sudoku_pool, or the working directory
+
+    // Refill from random puzzles of this archive; difficulties it lacks are still generated.
+    // Call before start().
+    bool useArchive(const std::string& path) noexcept;
+
+    static Puzzle generate(Difficulty difficulty) noexcept;
+
+private:
+    static int index(Difficulty difficulty) noexcept { return static_cast<int>(difficulty); }
+    Puzzle nextPuzzle(Difficulty difficulty) noexcept;     // from the archive if it has one, else generated
+    void refillLoop() noexcept;
+    void updateRefill(int slot) noexcept;           // caller holds mutex_
+
+    Watermarks marks_;
+    mutable std::mutex mutex_;
+    std::condition_variable refill_cv_;             // wakes the refill thread
+    std::array<std::vector<Puzzle>, DIFFICULTIES> puzzles_;
+    std::array<bool, DIFFICULTIES> refilling_{};    // between the low and high watermark crossings
+    bool stopping_ = false;
+    std::thread thread_;
+    PuzzleArchive archive_;                         // read-only once refills run
+};
+
+#endif // PUZZLE_POOL_HPP
@@ -0,0 +1,291 @@
+#include "SearchSolver.hpp"
+#include "SudokuGeometry.hpp"
+#include <algorithm>
+#include <bit>
+
+template <int BoxRows, int BoxCols>
+BasicSearchSolver<BoxRows, BoxCols>::BasicSearchSolver()
+    : trail_(std::make_unique_for_overwrite<Undo[]>(TRAIL_CAPACITY)) {}     // entries are written before they are read
+
+template <int BoxRows, int BoxCols>
+bool BasicSearchSolver<BoxRows, BoxCols>::solve(Grid& grid, std::mt19937* rng) noexcept {
+    stats_ = {};
+    rng_ = rng;
+    limit_ = 1;
+    solutions_ = 0;
+    if (!load(grid) || !search()) {
+        return false;
+    }
+    grid = solution_;
+    return true;
+}
+
+template <int BoxRows, int BoxCols>
+int BasicSearchSolver<BoxRows, BoxCols>::countSolutions(const Grid& grid, int limit) noexcept {
+    stats_ = {};
+    rng_ = nullptr;
+    limit_ = limit;
+    solutions_ = 0;
+    if (limit <= 0 || !load(grid)) {
+        return 0;
+    }
+    search();
+    return solutions_;
+}
+
+template <int BoxRows, int BoxCols>
+int BasicSearchSolver<BoxRows, BoxCols>::split(const Grid& grid, std::array<Grid, Board::SIZE>& children) noexcept {
+    stats_ = {};
+    if (!load(grid) || !propagate()) {
+        return 0;
+    }
+    if (state_.empty == 0) {
+        children[0] = state_.cells;
+        return 1;
+    }
+    int cell = pickBranchCell();
+    int count = 0;
+    for (Mask mask = state_.candidates[cell]; mask != 0; mask &= mask - 1) {
+        Grid& child = children[count++];
+        child = state_.cells;
+        child[cell] = static_cast<std::uint8_t>(std::countr_zero(mask) + 1);
+    }
+    return count;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSearchSolver<BoxRows, BoxCols>::load(const Grid& grid) noexcept {
+    state_ = {};
+    state_.candidates.fill(ALL_DIGITS);
+    clearTrail();
+    for (int cell = 0; cell < CELLS; ++cell) {
+        int value = grid[cell];
+        if (value == 0) continue;
+        if (value > SIZE || !(state_.candidates[cell] & (Mask{1} << (value - 1)))) {
+            return false;   // out-of-range digit or duplicate given
+        }
+        // an empty peer losing its last candidate is left for propagation to report
+        assign(cell, value);
+    }
+    clearTrail();       // the givens are never taken back
+    return true;
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSearchSolver<BoxRows, BoxCols>::narrow(int cell, Mask mask) noexcept {
+    trail_[trail_size_++] = {static_cast<std::uint16_t>(cell), state_.candidates[cell]};
+    state_.candidates[cell] = mask;
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSearchSolver<BoxRows, BoxCols>::undo(int trail_mark, int assigned_mark) noexcept {
+    while (assigned_size_ > assigned_mark) {
+        const int cell = assigned_[--assigned_size_];
+        // a digit goes into a unit once per path, so its used bit came from this cell
+        const Mask bit = static_cast<Mask>(Mask{1} << (state_.cells[cell] - 1));
+        for (auto unit : GEO.cell_units[cell]) {
+            state_.used[unit] &= static_cast<Mask>(~bit);
+        }
+        state_.cells[cell] = 0;
+        ++state_.empty;
+    }
+    while (trail_size_ > trail_mark) {
+        const Undo& entry = trail_[--trail_size_];
+        state_.candidates[entry.cell] = entry.mask;
+    }
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSearchSolver<BoxRows, BoxCols>::assign(int cell, int value) noexcept {
+    const Mask bit = static_cast<Mask>(Mask{1} << (value - 1));
+    if (!(state_.candidates[cell] & bit)) {
+        return false;
+    }
+    state_.cells[cell] = static_cast<std::uint8_t>(value);
+    assigned_[assigned_size_++] = static_cast<std::uint16_t>(cell);
+    narrow(cell, 0);
+    --state_.empty;
+    for (auto unit : GEO.cell_units[cell]) {
+        state_.used[unit] |= bit;
+    }
+    bool ok = true;
+    for (auto peer : GEO.peers[cell]) {
+        if (state_.candidates[peer] & bit) {
+            narrow(peer, static_cast<Mask>(state_.candidates[peer] & ~bit));
+            if (state_.candidates[peer] == 0) ok = false;
+        }
+    }
+    return ok;
+}
+
+template <int BoxRows, int BoxCols>
+int BasicSearchSolver<BoxRows, BoxCols>::nakedSingles() noexcept {
+    int filled = 0;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (state_.cells[cell] != 0) continue;
+        Mask mask = state_.candidates[cell];
+        if (mask == 0) return -1;
+        if (std::has_single_bit(mask)) {
+            if (!assign(cell, std::countr_zero(mask) + 1)) return -1;
+            ++filled;
+        }
+    }
+    return filled;
+}
+
+template <int BoxRows, int BoxCols>
+int BasicSearchSolver<BoxRows, BoxCols>::hiddenSingles() noexcept {
+    int filled = 0;
+    for (int unit = 0; unit < UNITS; ++unit) {
+        Mask once = 0;
+        Mask twice = 0;
+        for (auto cell : GEO.unit_cells[unit]) {
+            Mask mask = state_.candidates[cell];
+            twice |= once & mask;
+            once |= mask;
+        }
+        if ((once | state_.used[unit]) != ALL_DIGITS) return -1;   // some digit has nowhere to go
+        for (Mask lone = once & ~twice; lone != 0; lone &= lone - 1) {
+            const Mask bit = lone & -lone;
+            for (auto cell : GEO.unit_cells[unit]) {
+                if (state_.candidates[cell] & bit) {
+                    if (!assign(cell, std::countr_zero(bit) + 1)) return -1;
+                    ++filled;
+                    break;
+                }
+            }
+        }
+    }
+    return filled;
+}
+
+template <int BoxRows, int BoxCols>
+int BasicSearchSolver<BoxRows, BoxCols>::lockedCandidates() noexcept {
+    int eliminated = 0;
+    // strip bit from every cell of unit that is not in box (or, for a box, not in line)
+    auto eliminate = [&](int unit, int keep_unit, Mask bit, std::uint64_t& counter) {
+        for (auto cell : GEO.unit_cells[unit]) {
+            const auto& units = GEO.cell_units[cell];
+            if (units[0] == keep_unit || units[1] == keep_unit || units[2] == keep_unit) continue;
+            if (state_.candidates[cell] & bit) {
+                narrow(cell, static_cast<Mask>(state_.candidates[cell] & ~bit));
+                ++counter;
+                ++eliminated;
+            }
+        }
+    };
+
+    for (int box = 2 * SIZE; box < UNITS; ++box) {
+        for (Mask open = ALL_DIGITS & ~state_.used[box]; open != 0; open &= open - 1) {
+            const Mask bit = open & -open;
+            int row = -1, col = -1;
+            bool one_row = true, one_col = true;
+            for (auto cell : GEO.unit_cells[box]) {
+                if (!(state_.candidates[cell] & bit)) continue;
+                int r = GEO.cell_units[cell][0];
+                int c = GEO.cell_units[cell][1];
+                one_row = one_row && (row < 0 || row == r);
+                one_col = one_col && (col < 0 || col == c);
+                row = r;
+                col = c;
+            }
+            if (row < 0) continue;
+            // pointing: digit confined to one line inside the box, so the rest of that line loses it
+            if (one_row) eliminate(row, box, bit, stats_.pointing_eliminations);
+            if (one_col) eliminate(col, box, bit, stats_.pointing_eliminations);
+        }
+    }
+
+    for (int line = 0; line < 2 * SIZE; ++line) {
+        for (Mask open = ALL_DIGITS & ~state_.used[line]; open != 0; open &= open - 1) {
+            const Mask bit = open & -open;
+            int box = -1;
+            bool one_box = true;
+            for (auto cell : GEO.unit_cells[line]) {
+                if (!(state_.candidates[cell] & bit)) continue;
+                int b = GEO.cell_units[cell][2];
+                one_box = one_box && (box < 0 || box == b);
+                box = b;
+            }
+            // claiming: digit confined to one box along the line, so the rest of that box loses it
+            if (box >= 0 && one_box) eliminate(box, line, bit, stats_.claiming_eliminations);
+        }
+    }
+    return eliminated;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSearchSolver<BoxRows, BoxCols>::propagate() noexcept {
+    while (state_.empty > 0) {
+        int naked = nakedSingles();
+        if (naked < 0) return false;
+        stats_.naked_singles += naked;
+        stats_.forced += naked;
+        if (naked > 0) continue;
+
+        int hidden = hiddenSingles();
+        if (hidden < 0) return false;
+        stats_.hidden_singles += hidden;
+        stats_.forced += hidden;
+        if (hidden > 0) continue;
+
+        if (lockedCandidates() == 0) break;     // fixed point reached
+    }
+    return true;
+}
+
+template <int BoxRows, int BoxCols>
+int BasicSearchSolver<BoxRows, BoxCols>::pickBranchCell() const noexcept {
+    int best_cell = -1;
+    int best_count = SIZE + 1;
+    for (int cell = 0; cell < CELLS && best_count > 2; ++cell) {
+        if (state_.cells[cell] != 0) continue;
+        int count = std::popcount(state_.candidates[cell]);
+        if (count < best_count) {
+            best_cell = cell;
+            best_count = count;
+        }
+    }
+    return best_cell;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSearchSolver<BoxRows, BoxCols>::search() noexcept {
+    ++stats_.nodes;
+    if (cancel_ && cancel_->load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (!propagate()) {
+        ++stats_.backtracks;
+        return false;
+    }
+    if (state_.empty == 0) {
+        solution_ = state_.cells;
+        return ++solutions_ >= limit_;
+    }
+
+    int best_cell = pickBranchCell();
+
+    std::array<std::uint8_t, SIZE> values{};
+    int num_values = 0;
+    for (Mask mask = state_.candidates[best_cell]; mask != 0; mask &= mask - 1) {
+        values[num_values++] = static_cast<std::uint8_t>(std::countr_zero(mask) + 1);
+    }
+    if (rng_) {
+        std::shuffle(values.begin(), values.begin() + num_values, *rng_);
+    }
+
+    const int trail_mark = trail_size_;
+    const int assigned_mark = assigned_size_;
+    for (int i = 0; i < num_values; ++i) {
+        if (assign(best_cell, values[i]) && search()) return true;
+        undo(trail_mark, assigned_mark);
+    }
+    ++stats_.backtracks;
+    return false;
+}
+
+template class BasicSearchSolver<2, 2>;
+template class BasicSearchSolver<3, 3>;
+template class BasicSearchSolver<4, 4>;
+template class BasicSearchSolver<5, 5>;
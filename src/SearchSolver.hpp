@@ -0,0 +1,111 @@
+#ifndef SEARCH_SOLVER_HPP
+#define SEARCH_SOLVER_HPP
+
+#include "SudokuBoard.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+template <int BoxRows, int BoxCols>
+class BasicStepSolver;
+
+// Depth-first search that always branches on the empty cell with the fewest
+// candidates (minimum remaining values). Before every branch a propagation stage
+// applies naked singles, hidden singles and pointing/claiming eliminations until
+// nothing changes, so easy puzzles are solved without guessing at all.
+// Instantiated for the same geometries as BasicSudokuBoard.
+template <int BoxRows, int BoxCols>
+class BasicSearchSolver {
+public:
+    using Board = BasicSudokuBoard<BoxRows, BoxCols>;
+    using Grid = typename Board::Grid;
+    using SolveStats = SudokuBoardTypes::SolveStats;
+
+    BasicSearchSolver();                            // allocates the undo trail; reuse solvers on hot paths
+
+    // Solve grid in place. Candidate order is shuffled when rng is given, otherwise ascending.
+    // Returns false (leaving grid untouched) if the givens conflict or no solution exists.
+    bool solve(Grid& grid, std::mt19937* rng = nullptr) noexcept;
+
+    // Count solutions of grid, stopping as soon as limit are found (limit 2 answers "is it unique?").
+    int countSolutions(const Grid& grid, int limit) noexcept;
+
+    // Propagate grid, then split it on the cell with the fewest candidates: one child per
+    // candidate, each with the propagated singles filled in. Returns the number of children
+    // (0 if grid is contradictory); a grid solved by propagation alone yields one full child.
+    int split(const Grid& grid, std::array<Grid, Board::SIZE>& children) noexcept;
+
+    // Searches poll this flag at every node and give up as soon as it is set.
+    void setCancelFlag(const std::atomic<bool>* cancel) noexcept { cancel_ = cancel; }
+
+    const SolveStats& getStats() const noexcept { return stats_; }
+
+private:
+    template <int, int>
+    friend class BasicStepSolver;                   // drives the same state and rules one node at a time
+
+    using Geometry = typename Board::Geometry;
+    using Mask = typename Geometry::Mask;
+
+    static constexpr int SIZE = Board::SIZE;
+    static constexpr int CELLS = Board::CELLS;
+    static constexpr int UNITS = Geometry::UNITS;     // rows, then columns, then boxes
+    static constexpr Mask ALL_DIGITS = Geometry::ALL_DIGITS;
+    static constexpr const Geometry& GEO = SUDOKU_GEOMETRY<BoxRows, BoxCols>;
+
+    // everything a search node needs; search() undoes changes through the trail below
+    struct State {
+        Grid cells{};
+        std::array<Mask, CELLS> candidates{};           // 0 for filled cells
+        std::array<Mask, UNITS> used{};                 // digits placed in each unit
+        int empty = CELLS;
+    };
+
+    // a candidate mask as it was before a change
+    struct Undo {
+        std::uint16_t cell;
+        Mask mask;
+    };
+
+    bool load(const Grid& grid) noexcept;           // seed state, false on conflicting givens
+    bool search() noexcept;
+    void narrow(int cell, Mask mask) noexcept;      // set a cell's candidates, logging the old mask
+    void undo(int trail_mark, int assigned_mark) noexcept;     // roll the state back to the marks
+    void clearTrail() noexcept { trail_size_ = assigned_size_ = 0; }   // the current state becomes the root
+    int pickBranchCell() const noexcept;            // empty cell with the fewest candidates
+    bool assign(int cell, int value) noexcept;      // place value and strip it from the peers
+    bool propagate() noexcept;                      // run all rules to a fixed point, false on contradiction
+    int nakedSingles() noexcept;                    // returns cells filled, -1 on contradiction
+    int hiddenSingles() noexcept;
+    int lockedCandidates() noexcept;                // returns candidates eliminated
+
+    State state_{};
+
+    // Undo log of the current search path. Candidate masks only lose bits on the way down a path,
+    // so it holds at most CELLS * SIZE changes, and each cell is assigned at most once. The trail
+    // lives on the heap (125 KB at 25x25), so a solver on a small thread stack stays a few KB.
+    static constexpr int TRAIL_CAPACITY = CELLS * SIZE;
+    std::unique_ptr<Undo[]> trail_;
+    int trail_size_ = 0;
+    std::array<std::uint16_t, CELLS> assigned_{};   // cells in the order they were filled
+    int assigned_size_ = 0;
+
+    int limit_ = 1;                                 // stop after this many solutions
+    int solutions_ = 0;
+    Grid solution_{};
+
+    std::mt19937* rng_ = nullptr;
+    const std::atomic<bool>* cancel_ = nullptr;
+    SolveStats stats_{};
+};
+
+extern template class BasicSearchSolver<2, 2>;
+extern template class BasicSearchSolver<3, 3>;
+extern template class BasicSearchSolver<4, 4>;
+extern template class BasicSearchSolver<5, 5>;
+
+using SearchSolver = BasicSearchSolver<3, 3>;
+
+#endif // SEARCH_SOLVER_HPP
@@ -0,0 +1,340 @@
+#include "SolveCommand.hpp"
+#include "GenerateCommand.hpp"
+#include "PuzzleArchive.hpp"
+#include "SearchSolver.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void appendGrid(std::string& out, const SudokuBoard::Grid& grid, char blank) {
+    for (std::uint8_t value : grid) {
+        out.push_back(value == 0 ? blank : static_cast<char>('0' + value));
+    }
+}
+
+// the puzzle as the user wrote it for text input, re-rendered for packed input
+void appendPuzzle(std::string& out, const SudokuBoard::Grid& grid, std::string_view raw,
+                  PuzzleCorpus::Format format) {
+    if (format == PuzzleCorpus::Format::Text) {
+        out.append(raw);
+    } else {
+        appendGrid(out, grid, '.');
+    }
+}
+
+double percentile(std::vector<std::uint32_t>& values, double fraction) {
+    if (values.empty()) return 0.0;
+    auto rank = static_cast<std::size_t>(fraction * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank] / 1000.0;
+}
+
+int packCommand(int argc, char** argv) {
+    static constexpr const char* USAGE = "usage: sudoku pack [FILE|-] OUT [--archive [--solutions]]\n";
+    std::vector<std::string_view> paths;
+    bool archive = false;
+    bool solutions = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--archive") {
+            archive = true;
+        } else if (arg == "--solutions") {
+            archive = solutions = true;
+        } else if (arg == "-" || (!arg.empty() && arg[0] != '-')) {
+            paths.push_back(arg);
+        } else {
+            std::cerr << USAGE;
+            return 2;
+        }
+    }
+    if (paths.empty() || paths.size() > 2) {
+        std::cerr << USAGE;
+        return 2;
+    }
+    std::string_view input = paths.size() == 2 ? paths[0] : "-";
+    std::ofstream out(std::string(paths.back()), std::ios::binary);
+    std::ifstream file;
+    if (input != "-") file.open(std::string(input));
+    std::istream& in = input == "-" ? std::cin : file;
+    if (!in || !out) {
+        std::cerr << "sudoku pack: cannot open input or output\n";
+        return 1;
+    }
+
+    // an archive's index needs every difficulty's count up front, so its puzzles are collected first
+    std::vector<PuzzleArchive::Entry> entries;
+    std::vector<char> buffer;
+    if (!archive) {
+        PuzzleCorpus::writePackedHeader(out);
+        buffer.reserve(SolveCommand::CHUNK_BYTES);
+    }
+    SearchSolver solver;
+    std::string line;
+    SudokuBoard::Grid grid{};
+    std::size_t packed = 0;
+    std::size_t skipped = 0;
+    while (std::getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        if (!PuzzleCorpus::parseText(line, grid)) {
+            ++skipped;
+            continue;
+        }
+        if (archive) {
+            PuzzleArchive::Entry entry{GenerateCommand::rate(grid), grid, grid};
+            if (solutions && !solver.solve(entry.solution)) {
+                ++skipped;
+                continue;
+            }
+            entries.push_back(entry);
+            ++packed;
+            continue;
+        }
+        std::size_t at = buffer.size();
+        buffer.resize(at + PuzzleCorpus::PACKED_RECORD_SIZE);
+        PuzzleCorpus::pack(grid, reinterpret_cast<std::uint8_t*>(buffer.data() + at));
+        ++packed;
+        if (buffer.size() + PuzzleCorpus::PACKED_RECORD_SIZE > SolveCommand::CHUNK_BYTES) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    if (archive) {
+        PuzzleArchive::write(out, entries, solutions);
+    } else {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+    std::cerr << "packed " << packed << " puzzles, skipped " << skipped
+              << (solutions ? " malformed or unsolvable lines\n" : " malformed lines\n");
+    return out ? 0 : 1;
+}
+
+} // namespace
+
+SolveCommand::SolveCommand(Options options) noexcept : options_(std::move(options)) {
+    options_.threads = std::max(options_.threads, 1u);
+}
+
+void SolveCommand::begin() {
+    report_ = {};
+    report_.threads = options_.threads;
+    latency_.clear();
+    workers_.resize(options_.threads);
+    start_ = Clock::now();
+}
+
+std::optional<SolveCommand::Report> SolveCommand::run(std::istream& in, std::ostream& out) {
+    begin();
+    // one round of input for every thread, plus room for the partial record carried over
+    const bool supported = PuzzleCorpus::readBlocks(in, options_.threads * CHUNK_BYTES + CHUNK_BYTES,
+                                                    [&](std::span<const char> region, PuzzleCorpus::Format format) {
+        processRegion(region, format, out);
+    });
+    if (!supported) return std::nullopt;
+    return finish(out);
+}
+
+std::optional<SolveCommand::Report> SolveCommand::runFile(const std::string& path, std::ostream& out) {
+    PuzzleCorpus corpus;
+    if (!corpus.open(path)) return std::nullopt;
+    begin();
+    std::span<const char> data = corpus.records();
+    const std::size_t round = options_.threads * CHUNK_BYTES;
+    for (std::size_t offset = 0; offset < data.size();) {
+        std::size_t end = PuzzleCorpus::recordBoundary(data, offset + round, corpus.getFormat());
+        processRegion(data.subspan(offset, end - offset), corpus.getFormat(), out);
+        offset = end;
+    }
+    return finish(out);
+}
+
+void SolveCommand::processRegion(std::span<const char> data, PuzzleCorpus::Format format, std::ostream& out) {
+    const std::size_t threads = workers_.size();
+    std::vector<std::size_t> bounds(threads + 1, data.size());
+    bounds[0] = 0;
+    for (std::size_t t = 1; t < threads; ++t) {
+        bounds[t] = PuzzleCorpus::recordBoundary(data, std::max(bounds[t - 1], data.size() * t / threads), format);
+    }
+
+    // a failure on a worker thread (out of memory growing its output) is rethrown here
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            try {
+                processChunk(workers_[t], data.subspan(bounds[t], bounds[t + 1] - bounds[t]), format);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    try {
+        processChunk(workers_[0], data.first(bounds[1]), format);    // the calling thread takes the first chunk
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    for (Worker& worker : workers_) {
+        out.write(worker.output.data(), static_cast<std::streamsize>(worker.output.size()));
+        latency_.insert(latency_.end(), worker.latency.begin(), worker.latency.end());
+        report_.puzzles += worker.counts.puzzles;
+        report_.solved += worker.counts.solved;
+        report_.unsolvable += worker.counts.unsolvable;
+        report_.multiple += worker.counts.multiple;
+        report_.invalid += worker.counts.invalid;
+    }
+}
+
+void SolveCommand::processChunk(Worker& worker, std::span<const char> chunk, PuzzleCorpus::Format format) {
+    worker.output.clear();          // capacity is kept from round to round
+    worker.latency.clear();
+    worker.counts = {};
+    Report& counts = worker.counts;
+    if (options_.mode == Mode::Solve) {
+        // solving goes through the SIMD batch kernel, so records are queued and formatted a batch at a time
+        BatchSolver solver;
+        worker.records.clear();
+        PuzzleCorpus::forEachRecord(chunk, format, [&](const Grid& grid, bool ok, std::string_view raw) {
+            worker.records.push_back({grid, raw, ok});
+            if (worker.records.size() == BATCH_PUZZLES) {
+                solveBatch(worker, solver, format);
+            }
+        });
+        solveBatch(worker, solver, format);
+        return;
+    }
+    // BatchSolver stops at the first solution, so uniqueness checks keep the counting search
+    SearchSolver solver;
+    PuzzleCorpus::forEachRecord(chunk, format, [&](const Grid& grid, bool ok, std::string_view raw) {
+        ++counts.puzzles;
+        if (!ok) {
+            ++counts.invalid;
+            appendPuzzle(worker.output, grid, raw, format);
+            worker.output.append(" invalid\n");
+            return;
+        }
+        const auto start = Clock::now();
+        int found = solver.countSolutions(grid, 2);
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        worker.latency.push_back(static_cast<std::uint32_t>(std::min<long long>(ns, UINT32_MAX)));
+        counts.solved += found == 1;
+        counts.unsolvable += found == 0;
+        counts.multiple += found > 1;
+        appendPuzzle(worker.output, grid, raw, format);
+        worker.output.append(found == 1 ? " unique\n" : found == 0 ? " unsolvable\n" : " multiple\n");
+    });
+}
+
+void SolveCommand::solveBatch(Worker& worker, BatchSolver& solver, PuzzleCorpus::Format format) {
+    worker.puzzles.clear();
+    for (const Record& record : worker.records) {
+        if (record.ok) {
+            worker.puzzles.push_back(record.grid);
+        }
+    }
+    const std::size_t count = worker.puzzles.size();
+    worker.solutions.resize(count);
+    worker.solved.resize(count);
+    // the solver times each puzzle itself, so a slow fallback keeps its own latency
+    const std::size_t timed = worker.latency.size();
+    worker.latency.resize(timed + count);
+    solver.solve(worker.puzzles, worker.solutions, worker.solved, std::span(worker.latency).subspan(timed));
+
+    Report& counts = worker.counts;
+    std::size_t next = 0;
+    for (const Record& record : worker.records) {
+        ++counts.puzzles;
+        if (!record.ok) {
+            ++counts.invalid;
+            appendPuzzle(worker.output, record.grid, record.raw, format);
+            worker.output.append(" invalid\n");
+        } else if (worker.solved[next]) {
+            ++counts.solved;
+            appendGrid(worker.output, worker.solutions[next], '.');
+            worker.output.push_back('\n');
+        } else {
+            ++counts.unsolvable;
+            appendPuzzle(worker.output, record.grid, record.raw, format);
+            worker.output.append(" unsolvable\n");
+        }
+        next += record.ok;
+    }
+    worker.records.clear();
+}
+
+SolveCommand::Report SolveCommand::finish(std::ostream& out) {
+    out.flush();
+    report_.seconds = std::chrono::duration<double>(Clock::now() - start_).count();
+    report_.p50_us = percentile(latency_, 0.50);
+    report_.p90_us = percentile(latency_, 0.90);
+    report_.p99_us = percentile(latency_, 0.99);
+    report_.max_us = latency_.empty() ? 0.0 : *std::max_element(latency_.begin(), latency_.end()) / 1000.0;
+    return report_;
+}
+
+void SolveCommand::printReport(const Report& report, Mode mode, std::ostream& out) {
+    const double rate = report.seconds > 0.0 ? static_cast<double>(report.puzzles) / report.seconds : 0.0;
+    char buffer[256];
+    if (mode == Mode::Solve) {
+        std::snprintf(buffer, sizeof(buffer), "solved %zu/%zu puzzles (%zu unsolvable, %zu invalid)",
+                      report.solved, report.puzzles, report.unsolvable, report.invalid);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "validated %zu puzzles: %zu unique, %zu multiple, %zu unsolvable, %zu invalid",
+                      report.puzzles, report.solved, report.multiple, report.unsolvable, report.invalid);
+    }
+    out << buffer;
+    std::snprintf(buffer, sizeof(buffer),
+                  " in %.3f s on %u threads: %.0f puzzles/s\nlatency us: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+                  report.seconds, report.threads, rate, report.p50_us, report.p90_us, report.p99_us, report.max_us);
+    out << buffer;
+}
+
+int SolveCommand::main(int argc, char** argv) {
+    std::string_view command = argc > 0 ? argv[0] : "solve";
+    if (command == "pack") return packCommand(argc, argv);
+
+    const std::string usage = "usage: sudoku " + std::string(command) + " [FILE|-] [-j THREADS]\n";
+    Options options;
+    options.mode = command == "validate" ? Mode::Validate : Mode::Solve;
+    bool have_input = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "-j" || arg == "--threads") && i + 1 < argc) {
+            options.threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "-h" || arg == "--help") {
+            std::cout << usage;
+            return 0;
+        } else if (!have_input && (arg == "-" || (!arg.empty() && arg[0] != '-'))) {
+            options.input = arg;
+            have_input = true;
+        } else {
+            // a misspelt flag or -j without a value, not a file to read
+            std::cerr << usage;
+            return 2;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    SolveCommand solver(options);
+    auto report = options.input == "-" ? solver.run(std::cin, std::cout) : solver.runFile(options.input, std::cout);
+    if (!report) {
+        std::cerr << "sudoku " << command << ": cannot read " << (options.input == "-" ? "stdin" : options.input)
+                  << " (missing, or a packed header this build does not know)\n";
+        return 1;
+    }
+    printReport(*report, options.mode, std::cerr);
+    return report->solved == report->puzzles ? 0 : 1;
+}
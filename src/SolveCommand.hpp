@@ -0,0 +1,100 @@
+#ifndef SOLVE_COMMAND_HPP
+#define SOLVE_COMMAND_HPP
+
+#include "BatchSolver.hpp"
+#include "PuzzleCorpus.hpp"
+#include "SudokuBoard.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <chrono>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Non-interactive batch modes: `sudoku solve` writes the solution of every puzzle and
+// `sudoku validate` reports whether each puzzle has exactly one solution. Input is text
+// (one 81-character puzzle per line, `.` or `0` for blanks) or the packed binary format of
+// PuzzleCorpus, which includes PuzzleArchive files. Files are memory-mapped; stdin is read in large blocks. Each block is cut
+// on record boundaries into one chunk per thread, every thread formats its results into its
+// own buffer, and the buffers are written out in order with one large write each, so the
+// output lines match the input order. Failed puzzles are echoed with a trailing status word.
+// Solve mode feeds each chunk through BatchSolver in batches of BATCH_PUZZLES; validate mode
+// needs a second solution to rule out, so it uses SearchSolver's counting search.
+// Nothing here touches ncurses.
+class SolveCommand {
+public:
+    using Grid = SudokuBoard::Grid;
+
+    enum class Mode { Solve, Validate };
+
+    static constexpr std::size_t CHUNK_BYTES = 4u << 20;    // input handed to each thread per round
+    static constexpr std::size_t BATCH_PUZZLES = 256;       // records handed to BatchSolver at once in solve mode
+
+    struct Options {
+        std::string input = "-";                            // file path, "-" for stdin
+        unsigned threads = std::thread::hardware_concurrency();
+        Mode mode = Mode::Solve;
+    };
+
+    struct Report {
+        std::size_t puzzles = 0;
+        std::size_t solved = 0;         // solve: solved, validate: exactly one solution
+        std::size_t unsolvable = 0;
+        std::size_t multiple = 0;       // validate only
+        std::size_t invalid = 0;        // records that are not a well-formed puzzle
+        double seconds = 0.0;           // wall time of the whole run
+        double p50_us = 0.0;            // per-puzzle latency percentiles
+        double p90_us = 0.0;
+        double p99_us = 0.0;
+        double max_us = 0.0;
+        unsigned threads = 0;
+    };
+
+    explicit SolveCommand(Options options) noexcept;
+
+    // nullopt if the input cannot be read or starts with a packed header of another version
+    std::optional<Report> run(std::istream& in, std::ostream& out);            // streamed input
+    std::optional<Report> runFile(const std::string& path, std::ostream& out);   // mapped input
+
+    static void printReport(const Report& report, Mode mode, std::ostream& out);
+
+    // Entry point for `sudoku solve|validate [FILE|-] [-j THREADS]` and
+    // `sudoku pack [FILE|-] OUT [--archive [--solutions]]`; args start at the mode name.
+    // Archives are rated with GenerateCommand::rate to fill their difficulty index.
+    static int main(int argc, char** argv);
+
+private:
+    struct Record {
+        Grid grid;
+        std::string_view raw;
+        bool ok;
+    };
+
+    struct Worker {
+        std::string output;                     // formatted results of this thread's chunk
+        std::vector<std::uint32_t> latency;     // nanoseconds per well-formed puzzle
+        Report counts;
+        std::vector<Record> records;            // solve mode: records waiting for the next batch
+        std::vector<Grid> puzzles;
+        std::vector<Grid> solutions;
+        std::vector<std::uint8_t> solved;
+    };
+
+    void begin();
+    void processRegion(std::span<const char> data, PuzzleCorpus::Format format, std::ostream& out);
+    void processChunk(Worker& worker, std::span<const char> chunk, PuzzleCorpus::Format format);
+    void solveBatch(Worker& worker, BatchSolver& solver, PuzzleCorpus::Format format);
+    Report finish(std::ostream& out);
+
+    Options options_;
+    std::vector<Worker> workers_;
+    std::vector<std::uint32_t> latency_;
+    Report report_;
+    std::chrono::steady_clock::time_point start_{};
+};
+
+#endif // SOLVE_COMMAND_HPP
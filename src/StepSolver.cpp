@@ -0,0 +1,94 @@
+#include "StepSolver.hpp"
+#include <algorithm>
+#include <bit>
+
+template <int BoxRows, int BoxCols>
+bool BasicStepSolver<BoxRows, BoxCols>::start(const Grid& grid, std::mt19937* rng, int limit) noexcept {
+    stack_.clear();                 // capacity is kept for the next puzzle
+    engine_.stats_ = {};
+    engine_.rng_ = rng;
+    engine_.limit_ = limit;
+    engine_.solutions_ = 0;
+    if (limit <= 0 || !engine_.load(grid)) {
+        entering_ = false;
+        status_ = Status::Unsolvable;
+        return false;
+    }
+    entering_ = true;
+    status_ = Status::Running;
+    return true;
+}
+
+template <int BoxRows, int BoxCols>
+void BasicStepSolver<BoxRows, BoxCols>::reset() noexcept {
+    stack_.clear();
+    entering_ = false;
+    status_ = Status::Idle;
+}
+
+template <int BoxRows, int BoxCols>
+typename BasicStepSolver<BoxRows, BoxCols>::Status BasicStepSolver<BoxRows, BoxCols>::step(std::uint64_t nodes) noexcept {
+    while (status_ == Status::Running) {
+        if (entering_) {
+            if (nodes == 0) break;
+            --nodes;
+            entering_ = false;
+            if (!enter()) break;
+        }
+        if (stack_.empty()) {
+            finish();
+            break;
+        }
+        // next candidate of the innermost branch point, or give the point up
+        Frame& frame = stack_.back();
+        if (frame.next == frame.count) {
+            ++engine_.stats_.backtracks;
+            stack_.pop_back();
+            continue;
+        }
+        engine_.state_ = frame.saved;
+        engine_.clearTrail();       // frames restore whole states, the engine's log is not needed
+        entering_ = engine_.assign(frame.cell, frame.values[frame.next++]);
+    }
+    return status_;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicStepSolver<BoxRows, BoxCols>::enter() noexcept {
+    ++engine_.stats_.nodes;
+    if (!engine_.propagate()) {
+        ++engine_.stats_.backtracks;
+        return true;
+    }
+    if (engine_.state_.empty == 0) {
+        engine_.solution_ = engine_.state_.cells;
+        if (++engine_.solutions_ >= engine_.limit_) {
+            finish();
+            return false;
+        }
+        return true;                // counting on: backtrack for the next one
+    }
+
+    Frame& frame = stack_.emplace_back();
+    frame.saved = engine_.state_;
+    frame.cell = engine_.pickBranchCell();
+    for (auto mask = engine_.state_.candidates[frame.cell]; mask != 0; mask &= mask - 1) {
+        frame.values[frame.count++] = static_cast<std::uint8_t>(std::countr_zero(mask) + 1);
+    }
+    if (engine_.rng_) {
+        std::shuffle(frame.values.begin(), frame.values.begin() + frame.count, *engine_.rng_);
+    }
+    return true;
+}
+
+template <int BoxRows, int BoxCols>
+void BasicStepSolver<BoxRows, BoxCols>::finish() noexcept {
+    stack_.clear();
+    entering_ = false;
+    status_ = engine_.solutions_ > 0 ? Status::Solved : Status::Unsolvable;
+}
+
+template class BasicStepSolver<2, 2>;
+template class BasicStepSolver<3, 3>;
+template class BasicStepSolver<4, 4>;
+template class BasicStepSolver<5, 5>;
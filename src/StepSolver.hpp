@@ -0,0 +1,72 @@
+#ifndef STEP_SOLVER_HPP
+#define STEP_SOLVER_HPP
+
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// The MRV search of BasicSearchSolver run as a loop over an explicit stack of branch frames,
+// so it can be paused between nodes. start() loads a puzzle, step(n) visits at most n search
+// nodes and returns; the state stays in the object until the next start(). Propagation rules,
+// branching order and statistics are the same as SearchSolver's, so a run of steps finds the
+// same solution as one solve() with the same rng. Native stack use is constant; the search
+// stack lives on the heap and keeps its capacity from one puzzle to the next.
+template <int BoxRows, int BoxCols>
+class BasicStepSolver {
+public:
+    using Engine = BasicSearchSolver<BoxRows, BoxCols>;
+    using Grid = typename Engine::Grid;
+    using SolveStats = typename Engine::SolveStats;
+
+    enum class Status { Idle, Running, Solved, Unsolvable };
+
+    // Begin a search for up to limit solutions. Candidate order is shuffled when rng is given;
+    // rng must outlive the search. Returns false (status Unsolvable) if the givens conflict.
+    bool start(const Grid& grid, std::mt19937* rng = nullptr, int limit = 1) noexcept;
+
+    // Visit at most nodes search nodes. Solved once limit solutions are found, or when the
+    // tree is exhausted with at least one; Unsolvable when it is exhausted with none.
+    Status step(std::uint64_t nodes) noexcept;
+    Status run() noexcept { return step(UINT64_MAX); }
+
+    void reset() noexcept;                      // drop the search, back to Idle
+
+    Status getStatus() const noexcept { return status_; }
+    const Grid& getGrid() const noexcept { return engine_.state_.cells; }  // digits at the current node
+    const Grid& getSolution() const noexcept { return engine_.solution_; } // most recent solution found
+    int getSolutionCount() const noexcept { return engine_.solutions_; }
+    std::size_t getDepth() const noexcept { return stack_.size(); }       // open branch points
+    const SolveStats& getStats() const noexcept { return engine_.stats_; }
+
+private:
+    static constexpr int SIZE = Engine::SIZE;
+
+    // a branch point: the state before the guess and the candidates still to try
+    struct Frame {
+        typename Engine::State saved;
+        std::array<std::uint8_t, SIZE> values{};
+        int count = 0;
+        int next = 0;
+        int cell = -1;
+    };
+
+    bool enter() noexcept;                      // process the node in the engine's state, false when finished
+    void finish() noexcept;
+
+    Engine engine_;                             // owns the state, the rules and the counters
+    std::vector<Frame> stack_;
+    bool entering_ = false;                     // the engine's state is a node not yet visited
+    Status status_ = Status::Idle;
+};
+
+extern template class BasicStepSolver<2, 2>;
+extern template class BasicStepSolver<3, 3>;
+extern template class BasicStepSolver<4, 4>;
+extern template class BasicStepSolver<5, 5>;
+
+using StepSolver = BasicStepSolver<3, 3>;
+
+#endif // STEP_SOLVER_HPP
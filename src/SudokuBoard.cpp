@@ -1,208 +1,499 @@
 #include "SudokuBoard.hpp"
-#include <set>
+#include "SearchSolver.hpp"
+#include "DlxSolver.hpp"
+#include "ParallelSolver.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <numeric>
 
-SudokuBoard::SudokuBoard() noexcept {
-    // initialize 9x9 board with zeros
-    board_ = std::vector<std::vector<int>>(SIZE, std::vector<int>(SIZE, 0));
-
-    // all false for the prefilled tracker at initialization
-    pre_filled_ = std::vector<std::vector<bool>>(SIZE, std::vector<bool>(SIZE, false));
-
-    hints_used_ = 0;
-    moves_.clear();             // initialize empty move history
+template <int BoxRows, int BoxCols>
+BasicSudokuBoard<BoxRows, BoxCols>::BasicSudokuBoard() noexcept {
+    // all state is fixed-size and value-initialized: empty grid, no givens, empty move history
 }
 
-int SudokuBoard::getCell(int row, int col) const noexcept {
+template <int BoxRows, int BoxCols>
+int BasicSudokuBoard<BoxRows, BoxCols>::getCell(int row, int col) const noexcept {
     if (!isValidPosition(row, col)) {
         return 0; 
     }
-    return board_[row][col];
+    return at(row, col);
 }
 
-bool SudokuBoard::setCell(int row, int col, int value) noexcept {
-    if (!isValidPosition(row, col) || !isValidValue(value) || pre_filled_[row][col]) {
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::setCell(int row, int col, int value) noexcept {
+    if (!isValidPosition(row, col) || !isValidValue(value) || isGiven(cellIndex(row, col))) {
         return false;   // cant set the value for the cell (invalid position/ value/ pre-filled cell)
     }
 
-    if (moves_.size() >= MAX_UNDO) {
-        moves_.pop_front();     // Remove oldest move
+    if (undo_count_ == MAX_UNDO) {
+        undo_head_ = (undo_head_ + 1) % MAX_UNDO;     // overwrite oldest move
+        --undo_count_;
     }
-    moves_.push_back({row, col, board_[row][col]});
-    board_[row][col] = value;
+    moves_[(undo_head_ + undo_count_) % MAX_UNDO] = {static_cast<std::int8_t>(row), static_cast<std::int8_t>(col),
+                                                     static_cast<std::int8_t>(at(row, col))};
+    ++undo_count_;
+    writeCell(cellIndex(row, col), value);
     return true;
 }
 
-bool SudokuBoard::isValid() const noexcept {
-    // Trackers for rows, columns, and 3x3 boxes 
-    std::array<std::array<bool, SIZE + 1>, SIZE> rows{};
-    std::array<std::array<bool, SIZE + 1>, SIZE> cols{};
-    std::array<std::array<bool, SIZE + 1>, SIZE> boxes{};
-
-    // single pass through the board 
-    for (int row = 0; row < SIZE; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            int val = board_[row][col];
-            if (val == 0) continue; 
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isValid() const noexcept {
+    assert(conflicts_ == scanConflicts() && "conflict counter drifted from the grid");
+    return conflicts_ == 0;
+}
 
-            // check row for duplicates
-            if (rows[row][val]) return false; 
-            rows[row][val] = true;
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isFull() const noexcept {
+    assert(filled_ == scanFilled() && "filled counter drifted from the grid");
+    return filled_ == CELLS;
+}
 
-            // check col for duplicates
-            if (cols[col][val]) return false; 
-            cols[col][val] = true;
+template <int BoxRows, int BoxCols>
+int BasicSudokuBoard<BoxRows, BoxCols>::scanFilled() const noexcept {
+    return static_cast<int>(CELLS - std::count(cells_.begin(), cells_.end(), 0));
+}
 
-            // check 3x3 box for duplicates
-            int box_idx = (row / 3) * 3 + col / 3; 
-            if (boxes[box_idx][val]) return false; 
-            boxes[box_idx][val] = true;
+template <int BoxRows, int BoxCols>
+int BasicSudokuBoard<BoxRows, BoxCols>::scanConflicts() const noexcept {
+    // the original full walk: a digit seen twice in a unit marks every cell of that unit holding it
+    CellBits in_error{};
+    for (const auto& unit : GEO.unit_cells) {
+        DigitMask once = 0;
+        DigitMask twice = 0;
+        for (auto cell : unit) {
+            if (cells_[cell] == 0) continue;
+            twice |= once & digitBit(cells_[cell]);
+            once |= digitBit(cells_[cell]);
+        }
+        for (auto cell : unit) {
+            if (cells_[cell] != 0 && (twice & digitBit(cells_[cell]))) assignBit(in_error, cell, true);
         }
     }
-    return true;
+    int count = 0;
+    for (std::uint64_t word : in_error) count += std::popcount(word);
+    return count;
 }
 
-bool SudokuBoard::isFull() const noexcept {
-    for (const auto& row : board_) {
-        for (int val : row) {
-            if (val == 0) return false;     // found an empty cell
-        }
-    }
-    return true;
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::clear() noexcept {
+    cells_.fill(0);
+    given_.fill(0);
+    unit_used_.fill(0);
+    unit_repeated_.fill(0);
+    digit_count_ = {};
+    conflict_.fill(0);
+    filled_ = 0;
+    conflicts_ = 0;
+    solution_known_ = false;
+    given_mismatches_ = 0;
+    entry_mismatches_ = 0;
+    hints_used_ = 0;
+    undo_head_ = 0;
+    undo_count_ = 0;
 }
 
-void SudokuBoard::clear() noexcept {
-    for (auto& row : board_) {
-        std::fill(row.begin(), row.end(), 0);
-    }
-    for (auto& row : pre_filled_) {
-        std::fill(row.begin(), row.end(), false);
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isPreFilled(int row, int col) const noexcept {
+    if (!isValidPosition(row, col)) {
+        return false;
     }
-    hints_used_ = 0;
-    moves_.clear();
+    return isGiven(cellIndex(row, col));
 }
 
-bool SudokuBoard::isPreFilled(int row, int col) const noexcept {
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isInConflict(int row, int col) const noexcept {
     if (!isValidPosition(row, col)) {
         return false;
     }
-    return pre_filled_[row][col];
+    return testBit(conflict_, cellIndex(row, col));
 }
 
-bool SudokuBoard::isValidPosition(int row, int col) const noexcept {
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isGiven(int cell) const noexcept {
+    return testBit(given_, cell);
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::setGiven(int cell, bool value) noexcept {
+    if (solution_known_ && isGiven(cell) != value && cells_[cell] != 0 && cells_[cell] != solution_[cell]) {
+        // the mismatch moves between the givens' count and the entries'
+        given_mismatches_ += value ? 1 : -1;
+        entry_mismatches_ += value ? -1 : 1;
+    }
+    assignBit(given_, cell, value);
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::testBit(const CellBits& bits, int cell) noexcept {
+    return (bits[cell / 64] >> (cell % 64)) & 1u;
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::assignBit(CellBits& bits, int cell, bool value) noexcept {
+    std::uint64_t bit = std::uint64_t{1} << (cell % 64);
+    if (value) {
+        bits[cell / 64] |= bit;
+    } else {
+        bits[cell / 64] &= ~bit;
+    }
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isValidPosition(int row, int col) const noexcept {
     return row >= 0 && row < SIZE && col >= 0 && col < SIZE;
 }
 
-bool SudokuBoard::isValidValue(int value) const noexcept {
-    return value >= 0 && value <= 9; // 0 = empty, 1-9 = valid numbers
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isValidValue(int value) const noexcept {
+    return value >= 0 && value <= SIZE; // 0 = empty, 1-SIZE = valid numbers
 }
 
-bool SudokuBoard::isValidMove(int row, int col, int value) const noexcept {
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::isValidMove(int row, int col, int value) const noexcept {
     if (!isValidPosition(row, col) || !isValidValue(value) || value == 0) {
         return false;
     }
-    // Check row
-    for (int c = 0; c < SIZE; ++c) {
-        if (c != col && board_[row][c] == value) return false;
+    const int cell = cellIndex(row, col);
+    if (cells_[cell] == value) {
+        // the cell's own digit is in the masks, so only a duplicate elsewhere makes it invalid
+        return !hasPeerWithValue(cell, value);
+    }
+    return (usedMask(cell) & digitBit(value)) == 0;
+}
+
+template <int BoxRows, int BoxCols>
+auto BasicSudokuBoard<BoxRows, BoxCols>::getCandidates(int row, int col) const noexcept -> DigitMask {
+    if (!isValidPosition(row, col) || at(row, col) != 0) {
+        return 0;
+    }
+    return static_cast<DigitMask>(~usedMask(cellIndex(row, col)) & ALL_DIGITS);
+}
+
+template <int BoxRows, int BoxCols>
+int BasicSudokuBoard<BoxRows, BoxCols>::countCandidates(int row, int col) const noexcept {
+    return std::popcount(getCandidates(row, col));
+}
+
+template <int BoxRows, int BoxCols>
+auto BasicSudokuBoard<BoxRows, BoxCols>::usedMask(int cell) const noexcept -> DigitMask {
+    const auto& units = GEO.cell_units[cell];
+    return unit_used_[units[0]] | unit_used_[units[1]] | unit_used_[units[2]];
+}
+
+template <int BoxRows, int BoxCols>
+auto BasicSudokuBoard<BoxRows, BoxCols>::repeatedMask(int cell) const noexcept -> DigitMask {
+    const auto& units = GEO.cell_units[cell];
+    return unit_repeated_[units[0]] | unit_repeated_[units[1]] | unit_repeated_[units[2]];
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::placeDigit(int cell, int value) noexcept {
+    const DigitMask bit = digitBit(value);
+    trackSolution(cell, cells_[cell], value);
+    cells_[cell] = static_cast<std::uint8_t>(value);
+    ++filled_;
+    for (auto unit : GEO.cell_units[cell]) {
+        ++digit_count_[unit][value - 1];
+        unit_used_[unit] |= bit;
+    }
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::removeDigit(int cell) noexcept {
+    // placeDigit only writes digits absent from all three units, so the bit is ours alone
+    const int value = cells_[cell];
+    const DigitMask bit = digitBit(value);
+    trackSolution(cell, value, 0);
+    cells_[cell] = 0;
+    --filled_;
+    for (auto unit : GEO.cell_units[cell]) {
+        --digit_count_[unit][value - 1];
+        unit_used_[unit] &= static_cast<DigitMask>(~bit);
+    }
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::writeCell(int cell, int value) noexcept {
+    int old_value = cells_[cell];
+    if (old_value == value) return;
+    trackSolution(cell, old_value, value);
+    cells_[cell] = static_cast<std::uint8_t>(value);
+    filled_ += (value != 0) - (old_value != 0);
+    if (old_value != 0) uncountDigit(cell, old_value);
+    if (value != 0) countDigit(cell, value);
+    setConflict(cell, value != 0 && (repeatedMask(cell) & digitBit(value)));
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::countDigit(int cell, int value) noexcept {
+    const DigitMask bit = digitBit(value);
+    for (auto unit : GEO.cell_units[cell]) {
+        int count = ++digit_count_[unit][value - 1];
+        if (count == 1) {
+            unit_used_[unit] |= bit;
+        } else if (count == 2) {
+            unit_repeated_[unit] |= bit;
+            refreshConflicts(unit, value);
+        }
+    }
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::uncountDigit(int cell, int value) noexcept {
+    const DigitMask bit = digitBit(value);
+    for (auto unit : GEO.cell_units[cell]) {
+        int count = --digit_count_[unit][value - 1];
+        if (count == 0) {
+            unit_used_[unit] &= static_cast<DigitMask>(~bit);
+        } else if (count == 1) {
+            unit_repeated_[unit] &= static_cast<DigitMask>(~bit);
+            refreshConflicts(unit, value);
+        }
+    }
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::refreshConflicts(int unit, int value) noexcept {
+    // only runs when a digit starts or stops repeating in the unit
+    for (auto member : GEO.unit_cells[unit]) {
+        if (cells_[member] == value) {
+            setConflict(member, repeatedMask(member) & digitBit(value));
+        }
+    }
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::setConflict(int cell, bool value) noexcept {
+    conflicts_ += value - testBit(conflict_, cell);
+    assignBit(conflict_, cell, value);
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::hasPeerWithValue(int cell, int value) const noexcept {
+    for (auto peer : GEO.peers[cell]) {
+        if (cells_[peer] == value) return true;
+    }
+    return false;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::solveBoard(std::mt19937& rng) noexcept {
+    solve_stats_ = {};
+    switch (engine_) {
+        case SolverEngine::Backtracking: return solveBacktracking(rng);
+        case SolverEngine::MinRemaining: return solveMinRemaining(rng);
+        case SolverEngine::DancingLinks: return solveDancingLinks(rng);
+        case SolverEngine::Parallel: return solveParallel(rng);
+    }
+    return false;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::solveMinRemaining(std::mt19937& rng) noexcept {
+    // one solver per thread, so its undo trail is allocated once
+    thread_local BasicSearchSolver<BoxRows, BoxCols> solver;
+    Grid solved = cells_;
+    bool ok = solver.solve(solved, &rng);
+    solve_stats_ = solver.getStats();
+    if (!ok) return false;
+    fillFrom(solved);
+    return true;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::solveDancingLinks(std::mt19937& rng) noexcept {
+    if constexpr (!IS_CLASSIC) {
+        return solveMinRemaining(rng);
+    } else {
+        // the exact cover matrix is built once per thread and reused by every solve
+        thread_local DlxSolver solver;
+        Grid solved = cells_;
+        bool ok = solver.solve(solved, &rng);
+        solve_stats_ = solver.getStats();
+        if (!ok) return false;
+        fillFrom(solved);
+        return true;
     }
-    // Check column
-    for (int r = 0; r < SIZE; ++r) {
-        if (r != row && board_[r][col] == value) return false;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::solveParallel(std::mt19937& rng) noexcept {
+    if constexpr (!IS_CLASSIC) {
+        return solveMinRemaining(rng);
+    } else {
+        // work is spread over the shared pool; per-node stats stay with the workers
+        Grid solved = cells_;
+        if (!ParallelSolver::shared().solve(solved, &rng)) return false;
+        fillFrom(solved);
+        return true;
     }
-    // Check 3x3 box
-    int box_row = (row / 3) * 3;
-    int box_col = (col / 3) * 3;
-    for (int r = box_row; r < box_row + 3; ++r) {
-        for (int c = box_col; c < box_col + 3; ++c) {
-            if ((r != row || c != col) && board_[r][c] == value) return false;
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::fillFrom(const Grid& solved) noexcept {
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (cells_[cell] == 0) {
+            placeDigit(cell, solved[cell]);
         }
     }
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::trackSolution(int cell, int old_value, int new_value) noexcept {
+    if (!solution_known_) return;
+    std::int16_t& mismatches = isGiven(cell) ? given_mismatches_ : entry_mismatches_;
+    mismatches -= old_value != 0 && old_value != solution_[cell];
+    mismatches += new_value != 0 && new_value != solution_[cell];
+}
+
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::setSolution(const Grid& solved) noexcept {
+    solution_ = solved;
+    solution_known_ = true;
+    given_mismatches_ = 0;
+    entry_mismatches_ = 0;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        const bool mismatch = cells_[cell] != 0 && cells_[cell] != solved[cell];
+        (isGiven(cell) ? given_mismatches_ : entry_mismatches_) += mismatch;
+    }
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::adoptSolution(const Grid& solved) noexcept {
+    // rejected unless it is complete and keeps every given, so getHint can trust it; a player's
+    // wrong entries may disagree with it
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (solved[cell] == 0 || solved[cell] > SIZE || (isGiven(cell) && cells_[cell] != solved[cell])) {
+            return false;
+        }
+    }
+    setSolution(solved);
     return true;
 }
 
-bool SudokuBoard::solveBoard(std::mt19937& rng) noexcept {
-    for (int row = 0; row < SIZE; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            if (board_[row][col] == 0) {
-                // try numbers 1-9 in random order
-                std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-                std::shuffle(values.begin(), values.end(), rng);
-                for (int value : values) {
-                    if (isValidMove(row, col, value)) {
-                        board_[row][col] = value;
-                        if (solveBoard(rng)) return true;
-                        board_[row][col] = 0; // backtrack
-                    }
-                }
-                return false; // no valid number found
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::hasConsistentSolution() const noexcept {
+    return solution_known_ && given_mismatches_ == 0 && entry_mismatches_ == 0;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::hasAnswerKey() const noexcept {
+    return solution_known_ && given_mismatches_ == 0;
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::solveBacktracking(std::mt19937& rng) noexcept {
+    ++solve_stats_.nodes;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (cells_[cell] != 0) continue;
+        DigitMask candidates = static_cast<DigitMask>(~usedMask(cell) & ALL_DIGITS);
+        if (candidates == 0) { // dead end, nothing fits here
+            ++solve_stats_.backtracks;
+            return false;
+        }
+
+        // try numbers 1-SIZE in random order
+        std::array<int, SIZE> values{};
+        std::iota(values.begin(), values.end(), 1);
+        std::shuffle(values.begin(), values.end(), rng);
+        for (int value : values) {
+            if (candidates & digitBit(value)) {
+                placeDigit(cell, value);
+                if (solveBacktracking(rng)) return true;
+                removeDigit(cell); // backtrack
             }
         }
+        ++solve_stats_.backtracks;
+        return false; // no valid number found
     }
     return true; // board solved
 }
 
-std::optional<int> SudokuBoard::getHint(int row, int col, std::mt19937& rng) noexcept {
-    if (!isValidPosition(row, col) || pre_filled_[row][col] || hints_used_ >= MAX_HINTS) {
+template <int BoxRows, int BoxCols>
+std::optional<int> BasicSudokuBoard<BoxRows, BoxCols>::getHint(int row, int col, std::mt19937& rng) noexcept {
+    if (!isValidPosition(row, col) || isGiven(cellIndex(row, col)) || hints_used_ >= MAX_HINTS) {
         return std::nullopt; // Invalid position, pre-filled, or max hints reached
     }
 
-    // Try values 1-9 in random order
-    std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-    std::shuffle(values.begin(), values.end(), rng);
-    for (int value : values) {
-        if (isValidMove(row, col, value)) {
-            // Check if this value leads to a solvable board
-            int original = board_[row][col];
-            board_[row][col] = value;
-            SudokuBoard temp = *this; // Copy to test solvability
-            if (temp.solveBoard(rng)) {
-                board_[row][col] = original; // Restore original state
-                ++hints_used_;
-                return value;
+    if (!hasAnswerKey()) {
+        // no answer key for these givens yet: solve the current grid once, without the hinted
+        // cell's own entry, which may be the wrong digit being asked about
+        BasicSudokuBoard temp = *this;
+        temp.writeCell(cellIndex(row, col), 0);
+        if (!temp.solveBoard(rng)) {
+            // some other entry is wrong too, so answer from the givens alone
+            temp = *this;
+            for (int cell = 0; cell < CELLS; ++cell) {
+                if (!isGiven(cell)) temp.writeCell(cell, 0);
+            }
+            if (!temp.solveBoard(rng)) {
+                return std::nullopt; // No valid hint found
             }
-            board_[row][col] = original; // Restore if unsolvable
         }
+        setSolution(temp.cells_);
     }
-    return std::nullopt; // No valid hint found
+    ++hints_used_;
+    return solution_[cellIndex(row, col)];
 }
 
-int SudokuBoard::getHintsUsed() const noexcept {
+template <int BoxRows, int BoxCols>
+int BasicSudokuBoard<BoxRows, BoxCols>::getHintsUsed() const noexcept {
     return hints_used_;
 }
 
-void SudokuBoard::setPreFilled(int row, int col, bool value) noexcept {
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::setPreFilled(int row, int col, bool value) noexcept {
     if (isValidPosition(row, col)) {
-        pre_filled_[row][col] = value;
+        setGiven(cellIndex(row, col), value);
     }
 }
 
-// helper to remove cells while ensuring unique solution
-int SudokuBoard::removeCells(int to_remove, std::mt19937& rng) noexcept {
-    std::vector<std::pair<int, int>> cells;
-    for (int row = 0; row < SIZE; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            if (board_[row][col] != 0) {
-                cells.emplace_back(row, col);
-            }
+// counts solutions of the current grid, stopping once limit is reached
+template <int BoxRows, int BoxCols>
+int BasicSudokuBoard<BoxRows, BoxCols>::countSolutions(int limit) const noexcept {
+    // the backtracking engine has no counting mode, it shares the MRV search
+    if constexpr (IS_CLASSIC) {
+        if (engine_ == SolverEngine::DancingLinks) {
+            thread_local DlxSolver solver;
+            return solver.countSolutions(cells_, limit);
+        }
+        if (engine_ == SolverEngine::Parallel) {
+            return ParallelSolver::shared().countSolutions(cells_, limit);
         }
     }
-    std::shuffle(cells.begin(), cells.end(), rng);
-    
+    thread_local BasicSearchSolver<BoxRows, BoxCols> solver;
+    return solver.countSolutions(cells_, limit);
+}
+
+// helper to remove cells while keeping the solution unique; stops early when no further cell can go
+template <int BoxRows, int BoxCols>
+int BasicSudokuBoard<BoxRows, BoxCols>::removeCells(int to_remove, std::mt19937& rng) noexcept {
+    std::array<int, CELLS> cells{};
+    int filled = 0;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (cells_[cell] != 0) {
+            cells[filled++] = cell;
+        }
+    }
+    std::shuffle(cells.begin(), cells.begin() + filled, rng);
+
     int removed = 0;
-    for (const auto& [row, col] : cells) {
-        if (removed >= to_remove) break;
-        int backup = board_[row][col];
-        board_[row][col] = 0;
-        SudokuBoard temp = *this;
-        if (temp.solveBoard(rng)) {
+    for (int i = 0; i < filled && removed < to_remove && !cancelled(); ++i) {
+        int cell = cells[i];
+        int backup = cells_[cell];
+        writeCell(cell, 0);
+        if (countSolutions(2) == 1) {
             ++removed;
         } else {
-            board_[row][col] = backup;
+            writeCell(cell, backup);
         }
     }
     return removed;
 }
 
-void SudokuBoard::generatePuzzle(Difficulty difficulty) noexcept {
+template <int BoxRows, int BoxCols>
+void BasicSudokuBoard<BoxRows, BoxCols>::generatePuzzle(Difficulty difficulty) noexcept {
     // Clear board and reset hints
     clear();
     
@@ -210,103 +501,86 @@ void SudokuBoard::generatePuzzle(Difficulty difficulty) noexcept {
     std::random_device rd;
     std::mt19937 rng(rd());
     
-    // Generate full valid board
-    solveBoard(rng);
-    
     // Remove cells based on difficulty
-    int to_remove = 0;
-    switch (difficulty) {
-        case Difficulty::Easy:   to_remove = 41; break; // 40 cells remain
-        case Difficulty::Medium: to_remove = 56; break; // 25 cells remain
-        case Difficulty::Hard:   to_remove = 66; break; // 15 cells remain
+    const int to_remove = removalTarget(difficulty);
+
+    // Generate full valid boards and dig until the target is met, keeping the sparsest unique puzzle
+    Grid best{};
+    Grid best_solution{};
+    int best_removed = -1;
+    for (int attempt = 0; attempt < MAX_GENERATE_ATTEMPTS && best_removed < to_remove && !cancelled(); ++attempt) {
+        clear();
+        solveBoard(rng);
+        Grid solution = cells_;
+        int removed = removeCells(to_remove, rng);
+        if (removed > best_removed) {
+            best_removed = removed;
+            best = cells_;
+            best_solution = solution;
+        }
     }
-    removeCells(to_remove, rng);
-    
-    // Mark remaining cells as pre-filled
-    for (int row = 0; row < SIZE; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            pre_filled_[row][col] = (board_[row][col] != 0);
+    clear();
+    if (cancelled()) return;        // a dig cut short is easier than asked for, so none is kept
+    for (int cell = 0; cell < CELLS; ++cell) {
+        // remaining cells are the pre-filled givens
+        if (best[cell] != 0) {
+            placeDigit(cell, best[cell]);
+            setGiven(cell, true);
+        }
+    }
+    setSolution(best_solution);     // the puzzle is unique, so this is the only answer
+}
+
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::loadPuzzle(const Grid& puzzle, const Grid* solution) noexcept {
+    clear();
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (puzzle[cell] > SIZE) {
+            clear();
+            return false;
+        }
+        if (puzzle[cell] != 0) {
+            writeCell(cell, puzzle[cell]);  // stored givens are not trusted to be conflict-free
+            setGiven(cell, true);
         }
     }
+    if (solution) setSolution(*solution);
+    return true;
 }
 
-bool SudokuBoard::undo() noexcept {
-    if (moves_.empty()) {
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::undo() noexcept {
+    if (undo_count_ == 0) {
         return false;
     }
-    auto move = moves_.back();
-    moves_.pop_back();
-    if (isValidPosition(move.row, move.col) && !pre_filled_[move.row][move.col]) {
-        board_[move.row][move.col] = move.old_value;
+    --undo_count_;
+    Move move = moves_[(undo_head_ + undo_count_) % MAX_UNDO];
+    if (isValidPosition(move.row, move.col) && !isGiven(cellIndex(move.row, move.col))) {
+        writeCell(cellIndex(move.row, move.col), move.old_value);
         return true;
     }
     return false;
 }
 
-std::vector<std::pair<int, int>> SudokuBoard::findErrors() const noexcept {
-    std::set<std::pair<int, int>> error_cells;
-
-    // Check rows for duplicates
-    for (int r = 0; r < SIZE; ++r) {
-        std::array<std::vector<int>, SIZE + 1> seen_cols;
-        for (int c = 0; c < SIZE; ++c) {
-            int val = board_[r][c];
-            if (val != 0) {
-                seen_cols[val].push_back(c);
-            }
-        }
-        for (const auto& cols : seen_cols) {
-            if (cols.size() > 1) {
-                for (int c : cols) {
-                    error_cells.insert({r, c});
-                }
-            }
-        }
-    }
-
-    // Check columns for duplicates
-    for (int c = 0; c < SIZE; ++c) {
-        std::array<std::vector<int>, SIZE + 1> seen_rows;
-        for (int r = 0; r < SIZE; ++r) {
-            int val = board_[r][c];
-            if (val != 0) {
-                seen_rows[val].push_back(r);
-            }
-        }
-        for (const auto& rows : seen_rows) {
-            if (rows.size() > 1) {
-                for (int r : rows) {
-                    error_cells.insert({r, c});
-                }
-            }
-        }
-    }
-
-    // Check 3x3 boxes for duplicates
-    for (int box_start_row = 0; box_start_row < SIZE; box_start_row += 3) {
-        for (int box_start_col = 0; box_start_col < SIZE; box_start_col += 3) {
-            std::array<std::vector<std::pair<int, int>>, SIZE + 1> seen_coords;
-            for (int r = box_start_row; r < box_start_row + 3; ++r) {
-                for (int c = box_start_col; c < box_start_col + 3; ++c) {
-                    int val = board_[r][c];
-                    if (val != 0) {
-                        seen_coords[val].push_back({r, c});
-                    }
-                }
-            }
-            for (const auto& coords : seen_coords) {
-                if (coords.size() > 1) {
-                    for (const auto& p : coords) {
-                        error_cells.insert(p);
-                    }
-                }
-            }
+template <int BoxRows, int BoxCols>
+std::vector<std::pair<int, int>> BasicSudokuBoard<BoxRows, BoxCols>::findErrors() const noexcept {
+    // conflict_ is kept current by every write, so this only lists its set bits in row-major order
+    std::vector<std::pair<int, int>> errors;
+    for (int word = 0; word < static_cast<int>(conflict_.size()); ++word) {
+        for (std::uint64_t bits = conflict_[word]; bits != 0; bits &= bits - 1) {
+            int cell = word * 64 + std::countr_zero(bits);
+            errors.emplace_back(GEO.cell_units[cell][0], GEO.cell_units[cell][1] - SIZE);
         }
     }
+    return errors;
+}
 
-    return {error_cells.begin(), error_cells.end()};
+template <int BoxRows, int BoxCols>
+bool BasicSudokuBoard<BoxRows, BoxCols>::canUndo() const noexcept {
+    return undo_count_ != 0;
 }
 
-bool SudokuBoard::canUndo() const noexcept {
-    return !moves_.empty();
-}
\ No newline at end of file
+template class BasicSudokuBoard<2, 2>;
+template class BasicSudokuBoard<3, 3>;
+template class BasicSudokuBoard<4, 4>;
+template class BasicSudokuBoard<5, 5>;
@@ -1,29 +1,66 @@
 #ifndef SUDOKU_BOARD_HPP
 #define SUDOKU_BOARD_HPP
 
+#include "SudokuGeometry.hpp"
+#include <algorithm>
 #include <vector>
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <optional>
 #include <random>
-#include <deque>
+#include <span>
+#include <type_traits>
 #include <utility> // for std::pair
 
-class SudokuBoard {
-public:
+// Settings and result types shared by every board geometry.
+struct SudokuBoardTypes {
     static constexpr int MAX_HINTS = 3;                 // Maximum number of hints allowed
-    static constexpr int SIZE = 9;
     static constexpr size_t MAX_UNDO = 5;               // maximum undo history size
+    static constexpr int MAX_GENERATE_ATTEMPTS = 8;     // fresh grids tried when a difficulty's clue target is not reached
     enum class Difficulty { Easy, Medium, Hard };       // Difficulty levels for puzzle generation
+    enum class SolverEngine { Backtracking, MinRemaining, DancingLinks, Parallel };  // search strategy used by solveBoard
+
+    // counters from the most recent solveBoard call
+    struct SolveStats {
+        std::uint64_t nodes = 0;          // search nodes visited
+        std::uint64_t backtracks = 0;     // nodes that failed and were undone
+        std::uint64_t forced = 0;         // cells filled without branching (single candidate)
+        // propagation rule counters (MinRemaining engine only)
+        std::uint64_t naked_singles = 0;          // cells with one candidate left
+        std::uint64_t hidden_singles = 0;         // digits with one place left in a unit
+        std::uint64_t pointing_eliminations = 0;  // box-line reductions
+        std::uint64_t claiming_eliminations = 0;  // line-box reductions
+    };
 
     // struct to store a move for undo functionality
     struct Move {
-        int row;
-        int col;
-        int old_value;
+        std::int8_t row;
+        std::int8_t col;
+        std::int8_t old_value;
     };
+};
+
+// Board of BoxRows x BoxCols boxes holding digits 1..SIZE. Sizes, masks and loop bounds are
+// compile-time constants; the member functions are explicitly instantiated in SudokuBoard.cpp
+// for 4x4, 9x9, 16x16 and 25x25. DancingLinks and Parallel engines exist for 9x9 only, other
+// sizes solve with the MRV search.
+template <int BoxRows, int BoxCols>
+class BasicSudokuBoard : public SudokuBoardTypes {
+public:
+    using Geometry = BasicSudokuGeometry<BoxRows, BoxCols>;
+    using DigitMask = typename Geometry::Mask;          // bit (v - 1) set for digit v
+
+    static constexpr int BOX_ROWS = BoxRows;
+    static constexpr int BOX_COLS = BoxCols;
+    static constexpr int SIZE = Geometry::SIZE;
+    static constexpr int CELLS = SIZE * SIZE;           // number of cells in the grid
+
+    using Grid = std::array<std::uint8_t, CELLS>;                // row-major digits, 0 = empty
+    using GridView = std::span<const std::uint8_t, CELLS>;       // read-only view of a Grid
 
-    const std::vector<std::vector<int>>& getBoard() const { return board_; }    // getter for board_ for testing
-    SudokuBoard() noexcept;
+    GridView getBoard() const noexcept { return cells_; }        // row-major view of the digits
+    BasicSudokuBoard() noexcept;
     int getCell(int row, int col) const noexcept;
     bool setCell(int row, int col, int value) noexcept;
     bool isValid() const noexcept;
@@ -31,32 +68,133 @@ public:
     void clear() noexcept;
     bool isPreFilled(int row, int col) const noexcept;
     bool isValidMove(int row, int col, int value) const noexcept;   // check if placing value at (row, col) is valid
+    DigitMask getCandidates(int row, int col) const noexcept;       // bit (v - 1) set when digit v fits at (row, col)
+    int countCandidates(int row, int col) const noexcept;           // number of digits that fit at (row, col)
     bool solveBoard(std::mt19937& rng) noexcept;
+    void setSolverEngine(SolverEngine engine) noexcept { engine_ = engine; }
+    SolverEngine getSolverEngine() const noexcept { return engine_; }
+    const SolveStats& getSolveStats() const noexcept { return solve_stats_; }
+    int getFilledCount() const noexcept { return filled_; }      // non-empty cells
+    int getConflictCount() const noexcept { return conflicts_; } // cells whose digit repeats in a unit
+    int countSolutions(int limit = 2) const noexcept;           // solutions of the current grid, capped at limit
     std::optional<int> getHint(int row, int col, std::mt19937& rng) noexcept;      // get a hint for cell (row, col)
-    int getHintsUsed() const noexcept;                          // number of hints used  
+    bool hasConsistentSolution() const noexcept;                // a known solution agrees with every filled cell
+    bool hasAnswerKey() const noexcept;                         // a known solution agrees with every given, so hints may use it
+    bool adoptSolution(const Grid& solved) noexcept;            // use a solution found elsewhere as the hint answer key; it must fit the givens
+    std::optional<GridView> getSolution() const noexcept {      // the answer key, if one is known
+        return solution_known_ ? std::optional<GridView>(solution_) : std::nullopt;
+    }
+    int getHintsUsed() const noexcept;                          // number of hints used
     std::vector<std::pair<int, int>> findErrors() const noexcept;   // find all cells that violate Sudoku rules
+    bool isInConflict(int row, int col) const noexcept;             // the cell's digit repeats in its row, col or box
 
     // helper to check if a value is valid
     bool isValidValue(int value) const noexcept;
 
     // mark cell as pre-filled or not for testing and puzzle generation
-    void setPreFilled(int row, int col, bool value) noexcept;    
+    void setPreFilled(int row, int col, bool value) noexcept;
 
-    int removeCells(int to_remove, std::mt19937& rng) noexcept;           
-    void generatePuzzle(Difficulty difficulty) noexcept;          // generate a new puzzle of given difficulty      
-    bool undo() noexcept;                               // undo the last move  
-    bool canUndo() const noexcept;                     // check if undo is possible 
+    int removeCells(int to_remove, std::mt19937& rng) noexcept;
+    // cells generatePuzzle tries to empty, as a share of the grid (the 9x9 counts are exact)
+    static constexpr int removalTarget(Difficulty difficulty) noexcept {
+        switch (difficulty) {
+            case Difficulty::Easy:   return CELLS * 41 / 81;     // 40 cells remain
+            case Difficulty::Medium: return CELLS * 56 / 81;     // 25 cells remain
+            // 24 remain: a single unique dig reaches that about half the time, so the attempts
+            // in generatePuzzle almost always hit it; always at least one clue below Medium
+            case Difficulty::Hard:   return std::max(CELLS * 57 / 81, removalTarget(Difficulty::Medium) + 1);
+        }
+        return 0;
+    }
+    void generatePuzzle(Difficulty difficulty) noexcept;          // generate a new puzzle of given difficulty
+    // generatePuzzle and removeCells poll this between removals; a cancelled generation leaves the board empty
+    void setCancelFlag(const std::atomic<bool>* cancel) noexcept { cancel_ = cancel; }
+    // start a game from stored givens; a known solution primes the hint cache
+    bool loadPuzzle(const Grid& puzzle, const Grid* solution = nullptr) noexcept;
+    bool undo() noexcept;                               // undo the last move
+    bool canUndo() const noexcept;                     // check if undo is possible
 
 private:
-    std::vector<std::vector<int>> board_;                   // 9x9 grid
-    std::vector<std::vector<bool>> pre_filled_;             // to track original puzzle cells
-    
+    static constexpr bool IS_CLASSIC = BoxRows == 3 && BoxCols == 3;   // the only size the 9x9-specific engines handle
+    static constexpr DigitMask ALL_DIGITS = Geometry::ALL_DIGITS;
+    static constexpr const Geometry& GEO = SUDOKU_GEOMETRY<BoxRows, BoxCols>;   // peer and unit tables
+
+    using CellBits = std::array<std::uint64_t, (CELLS + 63) / 64>;   // one bit per cell
+
+    Grid cells_{};                                      // grid, flat row-major
+    CellBits given_{};                                  // bit per original puzzle cell
+
+    // per-unit digit bookkeeping (rows, then columns, then boxes), bit (v - 1) for digit v
+    std::array<std::array<std::uint8_t, SIZE>, Geometry::UNITS> digit_count_{};   // occurrences of each digit
+    std::array<DigitMask, Geometry::UNITS> unit_used_{};       // digits present at least once
+    std::array<DigitMask, Geometry::UNITS> unit_repeated_{};   // digits present more than once
+    CellBits conflict_{};                               // bit per cell whose digit repeats in one of its units
+    std::int16_t filled_ = 0;                           // non-empty cells, so isFull is a compare
+    std::int16_t conflicts_ = 0;                        // set bits in conflict_, so isValid is a compare
+
     // helper to check if a position is valid
     bool isValidPosition(int row, int col) const noexcept;
 
+    static constexpr int cellIndex(int row, int col) noexcept { return row * SIZE + col; }
+    static constexpr DigitMask digitBit(int value) noexcept { return static_cast<DigitMask>(DigitMask{1} << (value - 1)); }
+
+    int at(int row, int col) const noexcept { return cells_[cellIndex(row, col)]; }
+
+    // internal helpers take a flat cell index and walk the geometry tables
+    bool isGiven(int cell) const noexcept;
+    void setGiven(int cell, bool value) noexcept;
+    static bool testBit(const CellBits& bits, int cell) noexcept;
+    static void assignBit(CellBits& bits, int cell, bool value) noexcept;
+    DigitMask usedMask(int cell) const noexcept;                 // digits already present in the cell's row, col and box
+    DigitMask repeatedMask(int cell) const noexcept;             // digits repeated in the cell's row, col or box
+    void placeDigit(int cell, int value) noexcept;               // solver write: value must not already be in any unit
+    void removeDigit(int cell) noexcept;                         // solver undo of placeDigit
+    void writeCell(int cell, int value) noexcept;                // user write: keeps masks exact even with duplicates
+    void countDigit(int cell, int value) noexcept;               // add value to the counts of the cell's units
+    void uncountDigit(int cell, int value) noexcept;             // remove value from the counts of the cell's units
+    void refreshConflicts(int unit, int value) noexcept;         // recompute conflict bits of unit cells holding value
+    void setConflict(int cell, bool value) noexcept;             // write a conflict bit and keep conflicts_ in step
+    int scanFilled() const noexcept;                             // full recount, checked against filled_ in debug builds
+    int scanConflicts() const noexcept;                          // full recount, checked against conflicts_ in debug builds
+    bool hasPeerWithValue(int cell, int value) const noexcept;
+    bool solveBacktracking(std::mt19937& rng) noexcept;          // first-empty-cell recursion
+    bool solveMinRemaining(std::mt19937& rng) noexcept;          // delegates to SearchSolver
+    bool solveDancingLinks(std::mt19937& rng) noexcept;          // delegates to a per-thread DlxSolver
+    bool solveParallel(std::mt19937& rng) noexcept;              // delegates to the shared ParallelSolver
+    void fillFrom(const Grid& solved) noexcept;                  // copy a solution into the empty cells
+    void trackSolution(int cell, int old_value, int new_value) noexcept;   // keep the mismatch counts current
+    void setSolution(const Grid& solved) noexcept;               // remember solved as the answer key
+    bool cancelled() const noexcept { return cancel_ && cancel_->load(std::memory_order_relaxed); }
+
+    // answer key for getHint; a player's mistakes leave it standing, it is re-solved only while
+    // some given disagrees with it
+    Grid solution_{};
+    bool solution_known_ = false;
+    std::int16_t given_mismatches_ = 0;                // givens whose digit differs from solution_
+    std::int16_t entry_mismatches_ = 0;                // player entries whose digit differs from solution_
+
     int hints_used_ = 0;                  // count of hints used
+    SolverEngine engine_ = SolverEngine::MinRemaining;
+    SolveStats solve_stats_{};
+    const std::atomic<bool>* cancel_ = nullptr;     // set by setCancelFlag, not owned
 
-    std::deque<Move> moves_;               // stack to store moves for undo functionality
+    // fixed ring of the last MAX_UNDO moves, newest at (undo_head_ + undo_count_ - 1) % MAX_UNDO
+    std::array<Move, MAX_UNDO> moves_{};
+    std::uint8_t undo_head_ = 0;
+    std::uint8_t undo_count_ = 0;
 };
 
-#endif // SUDOKU_BOARD_HPP
\ No newline at end of file
+extern template class BasicSudokuBoard<2, 2>;
+extern template class BasicSudokuBoard<3, 3>;
+extern template class BasicSudokuBoard<4, 4>;
+extern template class BasicSudokuBoard<5, 5>;
+
+using SudokuBoard = BasicSudokuBoard<3, 3>;
+using SudokuBoard4 = BasicSudokuBoard<2, 2>;
+using SudokuBoard16 = BasicSudokuBoard<4, 4>;
+using SudokuBoard25 = BasicSudokuBoard<5, 5>;
+
+static_assert(std::is_trivially_copyable_v<SudokuBoard>, "board snapshots must be a plain memcpy");
+static_assert(std::is_trivially_copyable_v<SudokuBoard25>, "board snapshots must be a plain memcpy");
+
+#endif // SUDOKU_BOARD_HPP
@@ -0,0 +1,73 @@
+#ifndef SUDOKU_GEOMETRY_HPP
+#define SUDOKU_GEOMETRY_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// Compile-time cell/unit relationship tables for a grid of BoxRows x BoxCols boxes
+// (SIZE = BoxRows * BoxCols digits). Units are numbered rows, then columns, then boxes.
+template <int BoxRows, int BoxCols>
+struct BasicSudokuGeometry {
+    static_assert(BoxRows >= 1 && BoxCols >= 1 && BoxRows * BoxCols <= 36, "digits must fit a 64-bit mask and a byte");
+    static constexpr int BOX_ROWS = BoxRows;
+    static constexpr int BOX_COLS = BoxCols;
+    static constexpr int SIZE = BoxRows * BoxCols;
+    static constexpr int CELLS = SIZE * SIZE;
+    static constexpr int UNITS = 3 * SIZE;
+    static constexpr int PEERS = 2 * (SIZE - 1) + (BoxRows - 1) * (BoxCols - 1);   // 20 for 9x9
+
+    // narrowest types that can name a cell or a unit
+    using Cell = std::conditional_t<(CELLS <= 256), std::uint8_t, std::uint16_t>;
+    using Unit = std::conditional_t<(UNITS <= 256), std::uint8_t, std::uint16_t>;
+    // digit set with bit (v - 1) for digit v
+    using Mask = std::conditional_t<(SIZE <= 16), std::uint16_t,
+                 std::conditional_t<(SIZE <= 32), std::uint32_t, std::uint64_t>>;
+    static constexpr Mask ALL_DIGITS = static_cast<Mask>((std::uint64_t{1} << SIZE) - 1);
+
+    std::array<std::array<Cell, SIZE>, UNITS> unit_cells{};     // members of each unit
+    std::array<std::array<Unit, 3>, CELLS> cell_units{};         // row, column and box unit of each cell
+    std::array<std::array<Cell, PEERS>, CELLS> peers{};          // each peer listed once
+};
+
+template <int BoxRows, int BoxCols>
+constexpr BasicSudokuGeometry<BoxRows, BoxCols> makeSudokuGeometry() {
+    using Geometry = BasicSudokuGeometry<BoxRows, BoxCols>;
+    using Cell = typename Geometry::Cell;
+    using Unit = typename Geometry::Unit;
+    constexpr int SIZE = Geometry::SIZE;
+    Geometry g{};
+    for (int cell = 0; cell < Geometry::CELLS; ++cell) {
+        int row = cell / SIZE;
+        int col = cell % SIZE;
+        int box = (row / BoxRows) * BoxRows + col / BoxCols;
+        int pos_in_box = (row % BoxRows) * BoxCols + col % BoxCols;
+        g.unit_cells[row][col] = static_cast<Cell>(cell);
+        g.unit_cells[SIZE + col][row] = static_cast<Cell>(cell);
+        g.unit_cells[2 * SIZE + box][pos_in_box] = static_cast<Cell>(cell);
+        g.cell_units[cell] = {static_cast<Unit>(row), static_cast<Unit>(SIZE + col),
+                              static_cast<Unit>(2 * SIZE + box)};
+    }
+    // walk the cell's own units rather than the whole grid so 25x25 stays cheap to evaluate;
+    // box cells that share the row or column were already listed by the line units
+    for (int cell = 0; cell < Geometry::CELLS; ++cell) {
+        const auto& units = g.cell_units[cell];
+        int count = 0;
+        for (int u = 0; u < 3; ++u) {
+            for (Cell other : g.unit_cells[units[u]]) {
+                if (other == cell) continue;
+                if (u == 2 && (g.cell_units[other][0] == units[0] || g.cell_units[other][1] == units[1])) continue;
+                g.peers[cell][count++] = other;
+            }
+        }
+    }
+    return g;
+}
+
+template <int BoxRows, int BoxCols>
+inline constexpr BasicSudokuGeometry<BoxRows, BoxCols> SUDOKU_GEOMETRY = makeSudokuGeometry<BoxRows, BoxCols>();
+
+using SudokuGeometry = BasicSudokuGeometry<3, 3>;
+inline constexpr const SudokuGeometry& GEOMETRY = SUDOKU_GEOMETRY<3, 3>;
+
+#endif // SUDOKU_GEOMETRY_HPP
@@ -1,16 +1,59 @@
+#include "DedupeCommand.hpp"
+#include "GenerateCommand.hpp"
+#include "SolveCommand.hpp"
+#include <iostream>
+#include <string_view>
+#ifdef SUDOKU_WITH_UI
 #include "GameController.hpp"
 #include "SudokuBoard.hpp"
 #include "GameUI.hpp"
+#include "PuzzlePool.hpp"
 #include <memory>
+#endif
 
-int main() {
+int main(int argc, char** argv) {
+    // batch modes are dispatched before anything touches the terminal
+    if (argc > 1) {
+        std::string_view mode = argv[1];
+        if (mode == "solve" || mode == "validate" || mode == "pack") {
+            return SolveCommand::main(argc - 1, argv + 1);
+        }
+        if (mode == "generate") {
+            return GenerateCommand::main(argc - 1, argv + 1);
+        }
+        if (mode == "dedupe") {
+            return DedupeCommand::main(argc - 1, argv + 1);
+        }
+    }
+
+#ifdef SUDOKU_WITH_UI
     SudokuBoard board;
 
+    // puzzles left over from the last run make the first game instant; the rest are made in the background
+    PuzzlePool pool;
+    // `sudoku --puzzles ARCHIVE` deals new games out of a prepared library
+    if (argc > 2 && std::string_view(argv[1]) == "--puzzles" && !pool.useArchive(argv[2])) {
+        std::cerr << "sudoku: " << argv[2] << " is not a puzzle archive\n";
+        return 1;
+    }
+    const std::string pool_path = PuzzlePool::defaultPath();
+    pool.load(pool_path);
+    pool.start();
+
     auto ui = std::make_unique<GameUI>(board);
 
-    GameController game(board, std::move(ui));
+    GameController game(board, std::move(ui), &pool);
 
     game.run();
+
+    pool.stop();
+    pool.save(pool_path);
     
     return 0;
-}
\ No newline at end of file
+#else
+    std::cerr << "usage: sudoku solve|validate [FILE|-] [-j THREADS]\n"
+                 "       sudoku generate COUNT [-o FILE] [-d easy|medium|hard]\n"
+                 "       sudoku dedupe [FILE|-] [-o OUT] [--canonical]  (built without the ncurses game)\n";
+    return 2;
+#endif
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "DlxSolver.hpp"
+#include "ParallelSolver.hpp"
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Every global allocation in this binary goes through these replacements, so a test can
+// assert that a stretch of code made none. Counting is global, which also covers the
+// ParallelSolver workers.
+namespace {
+
+std::atomic<std::size_t> allocations{0};
+
+// counted allocation; nullptr on failure, which the throwing forms turn into bad_alloc
+void* allocateOrNull(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    return alignment > alignof(std::max_align_t)
+               ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+               : std::malloc(size);
+}
+
+void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    void* memory = allocateOrNull(size, alignment);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocateOrNull(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocateOrNull(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+namespace {
+
+using Engine = SudokuBoard::SolverEngine;
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+
+SudokuBoard::Grid parse(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        grid[i] = text[i] == '.' ? 0 : static_cast<std::uint8_t>(text[i] - '0');
+    }
+    return grid;
+}
+
+// allocations made by work(); run it once beforehand so one-time setup is not counted
+template <typename Work>
+std::size_t allocationsAfterWarmup(Work&& work) {
+    work();
+    const std::size_t before = allocations.load();
+    work();
+    return allocations.load() - before;
+}
+
+} // namespace
+
+TEST(AllocationTest, SolveBoard_EveryEngine) {
+    const SudokuBoard::Grid puzzle = parse(HARD_PUZZLE);
+    for (Engine engine : {Engine::Backtracking, Engine::MinRemaining, Engine::DancingLinks, Engine::Parallel}) {
+        SudokuBoard board;
+        board.setSolverEngine(engine);
+        std::mt19937 rng(1);
+        EXPECT_EQ(allocationsAfterWarmup([&] {
+                      board.loadPuzzle(puzzle);
+                      EXPECT_TRUE(board.solveBoard(rng));
+                  }),
+                  0u)
+            << "engine " << static_cast<int>(engine);
+    }
+}
+
+TEST(AllocationTest, CountSolutions_EveryEngine) {
+    SudokuBoard board;
+    board.loadPuzzle(parse(HARD_PUZZLE));
+    for (Engine engine : {Engine::MinRemaining, Engine::DancingLinks, Engine::Parallel}) {
+        board.setSolverEngine(engine);
+        EXPECT_EQ(allocationsAfterWarmup([&] { EXPECT_EQ(board.countSolutions(2), 1); }), 0u)
+            << "engine " << static_cast<int>(engine);
+    }
+}
+
+TEST(AllocationTest, GenerateDigAndHint) {
+    for (Engine engine : {Engine::MinRemaining, Engine::DancingLinks}) {
+        SudokuBoard board;
+        board.setSolverEngine(engine);
+        std::mt19937 rng(2);
+        EXPECT_EQ(allocationsAfterWarmup([&] { board.generatePuzzle(SudokuBoard::Difficulty::Medium); }), 0u);
+        EXPECT_EQ(allocationsAfterWarmup([&] {
+                      board.loadPuzzle(parse(HARD_PUZZLE));     // no solution given, so the hint solves
+                      EXPECT_TRUE(board.getHint(8, 8, rng).has_value());
+                  }),
+                  0u);
+        EXPECT_EQ(allocationsAfterWarmup([&] {
+                      SudokuBoard full;
+                      full.setSolverEngine(engine);
+                      full.solveBoard(rng);
+                      full.removeCells(50, rng);
+                  }),
+                  0u);
+    }
+}
+
+TEST(AllocationTest, SolversDirectly) {
+    SudokuBoard::Grid puzzle = parse(HARD_PUZZLE);
+    SearchSolver search;
+    DlxSolver dlx;
+    ParallelSolver parallel(4);
+    std::mt19937 rng(3);
+    EXPECT_EQ(allocationsAfterWarmup([&] {
+                  SudokuBoard::Grid grid = puzzle;
+                  EXPECT_TRUE(search.solve(grid, &rng));
+                  EXPECT_EQ(search.countSolutions(puzzle, 2), 1);
+              }),
+              0u);
+    EXPECT_EQ(allocationsAfterWarmup([&] {
+                  SudokuBoard::Grid grid = puzzle;
+                  EXPECT_TRUE(dlx.solve(grid, &rng));
+                  EXPECT_EQ(dlx.countSolutions(puzzle, 2), 1);
+              }),
+              0u);
+    EXPECT_EQ(allocationsAfterWarmup([&] {
+                  SudokuBoard::Grid grid{};       // an empty grid splits into the most tasks
+                  EXPECT_TRUE(parallel.solve(grid, &rng));
+                  EXPECT_EQ(parallel.countSolutions(puzzle, 2), 1);
+              }),
+              0u);
+}
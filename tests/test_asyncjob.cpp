@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include "AsyncJob.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+TEST(AsyncJobTest, Take_ReturnsTheWorkResult) {
+    AsyncJob<int> job;
+    EXPECT_FALSE(job.isRunning());
+    job.start([](std::stop_token) -> std::optional<int> { return 42; });
+    EXPECT_TRUE(job.isRunning());
+    EXPECT_EQ(job.take(), 42);
+    EXPECT_FALSE(job.isRunning()) << "A taken job should free its slot";
+}
+
+TEST(AsyncJobTest, Take_RethrowsWhatTheWorkThrew) {
+    AsyncJob<int> job;
+    job.start([](std::stop_token) -> std::optional<int> { throw std::runtime_error("no puzzle"); });
+    EXPECT_THROW(job.take(), std::runtime_error);
+    EXPECT_FALSE(job.isRunning());
+
+    job.start([](std::stop_token) -> std::optional<int> { return 7; });
+    EXPECT_EQ(job.take(), 7) << "The job should be reusable after a throw";
+}
+
+TEST(AsyncJobTest, Cancel_StopsTheWorkAndDropsItsResult) {
+    AsyncJob<int> job;
+    std::atomic<bool> saw_stop{false};
+    job.start([&saw_stop](std::stop_token stop) -> std::optional<int> {
+        while (!stop.stop_requested()) {
+            std::this_thread::yield();
+        }
+        saw_stop = true;
+        return std::nullopt;
+    });
+    job.cancel();
+    EXPECT_TRUE(saw_stop);
+    EXPECT_FALSE(job.isRunning());
+}
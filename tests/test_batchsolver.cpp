@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "BatchSolver.hpp"
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+std::vector<SudokuBoard::Grid> makePuzzles(int count) {
+    std::vector<SudokuBoard::Grid> puzzles;
+    const SudokuBoard::Difficulty levels[] = {SudokuBoard::Difficulty::Easy, SudokuBoard::Difficulty::Medium,
+                                              SudokuBoard::Difficulty::Hard};
+    for (int i = 0; i < count; ++i) {
+        SudokuBoard board;
+        board.generatePuzzle(levels[i % 3]);
+        SudokuBoard::Grid grid{};
+        std::copy(board.getBoard().begin(), board.getBoard().end(), grid.begin());
+        puzzles.push_back(grid);
+    }
+    return puzzles;
+}
+
+} // namespace
+
+TEST(BatchSolverTest, DetectIsa_IsSupported) {
+    BatchSolver::Isa isa = BatchSolver::detectIsa();
+    EXPECT_TRUE(BatchSolver::isSupported(isa));
+    EXPECT_TRUE(BatchSolver::isSupported(BatchSolver::Isa::Scalar));
+    EXPECT_EQ(BatchSolver().getIsa(), isa);
+}
+
+TEST(BatchSolverTest, Solve_EveryIsaMatchesScalarSearch) {
+    // 37 puzzles: several full packs plus a partial last pack on every ISA
+    std::vector<SudokuBoard::Grid> puzzles = makePuzzles(37);
+    puzzles[5][0] = 4;
+    puzzles[5][1] = 4;                      // conflicting givens, unsolvable
+
+    std::vector<SudokuBoard::Grid> expected = puzzles;
+    std::vector<bool> expected_ok;
+    SearchSolver reference;
+    for (auto& grid : expected) {
+        expected_ok.push_back(reference.solve(grid));
+    }
+
+    for (auto isa : {BatchSolver::Isa::Scalar, BatchSolver::Isa::Sse2, BatchSolver::Isa::Avx2}) {
+        if (!BatchSolver::isSupported(isa)) continue;
+        BatchSolver batch(isa);
+        std::vector<SudokuBoard::Grid> solutions(puzzles.size());
+        std::vector<std::uint8_t> solved(puzzles.size());
+        std::size_t count = batch.solve(puzzles, solutions, solved);
+
+        EXPECT_EQ(count, puzzles.size() - 1) << BatchSolver::isaName(isa);
+        EXPECT_EQ(batch.getStats().puzzles, puzzles.size());
+        for (std::size_t i = 0; i < puzzles.size(); ++i) {
+            EXPECT_EQ(solved[i] != 0, expected_ok[i]) << BatchSolver::isaName(isa) << " puzzle " << i;
+            if (expected_ok[i]) {
+                EXPECT_EQ(solutions[i], expected[i]) << BatchSolver::isaName(isa) << " puzzle " << i;
+            }
+        }
+        if (isa != BatchSolver::Isa::Scalar) {
+            EXPECT_GT(batch.getStats().lockstep_solved, 0u) << "Easy puzzles should finish in the vector kernel";
+        }
+    }
+}
+
+TEST(BatchSolverTest, Solve_TimesEachPuzzleOnItsOwn) {
+    std::vector<SudokuBoard::Grid> puzzles = makePuzzles(9);
+    puzzles[4] = SudokuBoard::Grid{};       // nothing for the kernel to do, all search
+
+    for (auto isa : {BatchSolver::Isa::Scalar, BatchSolver::Isa::Sse2, BatchSolver::Isa::Avx2}) {
+        if (!BatchSolver::isSupported(isa)) continue;
+        BatchSolver batch(isa);
+        std::vector<SudokuBoard::Grid> solutions(puzzles.size());
+        std::vector<std::uint8_t> solved(puzzles.size());
+        std::vector<std::uint32_t> latency(puzzles.size());
+        EXPECT_EQ(batch.solve(puzzles, solutions, solved, latency), puzzles.size()) << BatchSolver::isaName(isa);
+
+        EXPECT_EQ(std::count(latency.begin(), latency.end(), 0u), 0) << BatchSolver::isaName(isa);
+        EXPECT_GT(latency[4], *std::min_element(latency.begin(), latency.end()))
+            << BatchSolver::isaName(isa) << ": the searched puzzle should not share the batch average";
+    }
+}
+
+TEST(BatchSolverTest, Solve_RejectsAFullGridThatBreaksTheRules) {
+    SudokuBoard::Grid full{};
+    SearchSolver reference;
+    ASSERT_TRUE(reference.solve(full));
+    std::vector<SudokuBoard::Grid> puzzles(3, full);
+    std::swap(puzzles[1][0], puzzles[1][1]);    // every cell a single, but columns 0 and 1 now repeat
+
+    for (auto isa : {BatchSolver::Isa::Scalar, BatchSolver::Isa::Sse2, BatchSolver::Isa::Avx2}) {
+        if (!BatchSolver::isSupported(isa)) continue;
+        BatchSolver batch(isa);
+        std::vector<SudokuBoard::Grid> solutions(puzzles.size());
+        std::vector<std::uint8_t> solved(puzzles.size());
+        EXPECT_EQ(batch.solve(puzzles, solutions, solved), 2u) << BatchSolver::isaName(isa);
+        EXPECT_FALSE(solved[1]) << BatchSolver::isaName(isa) << ": complete lanes must still be checked";
+    }
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "BoundedQueue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST(BoundedQueueTest, SingleThread_FifoAndCapacity) {
+    BoundedQueue<int> queue(3);     // rounded up to 4
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4)) << "Full queue should refuse a push";
+    EXPECT_EQ(queue.size(), 4u);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value)) << "Empty queue should refuse a pop";
+
+    // wrap around several laps
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(queue.tryPush(i));
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(BoundedQueueTest, ManyProducersAndConsumers_DeliverEveryItemOnce) {
+    constexpr int PRODUCERS = 3;
+    constexpr int CONSUMERS = 3;
+    constexpr int PER_PRODUCER = 20000;
+    BoundedQueue<std::uint32_t> queue(64);
+    std::atomic<int> producers_left{PRODUCERS};
+    std::vector<std::atomic<int>> seen(PRODUCERS * PER_PRODUCER);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                while (!queue.tryPush(static_cast<std::uint32_t>(p * PER_PRODUCER + i))) std::this_thread::yield();
+            }
+            producers_left.fetch_sub(1);
+        });
+    }
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&] {
+            std::uint32_t value = 0;
+            while (true) {
+                if (queue.tryPop(value)) {
+                    seen[value].fetch_add(1);
+                } else if (producers_left.load() == 0) {
+                    if (!queue.tryPop(value)) break;
+                    seen[value].fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "item " << i;
+    }
+}
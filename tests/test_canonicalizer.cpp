@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "Canonicalizer.hpp"
+#include "GridTransform.hpp"
+#include "SearchSolver.hpp"
+#include <algorithm>
+#include <string>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+
+SudokuBoard::Grid parse(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        grid[i] = text[i] == '.' ? 0 : static_cast<std::uint8_t>(text[i] - '0');
+    }
+    return grid;
+}
+
+// the minlex form by trying every one of the 2 * 6^8 transforms; early exit keeps it to a second or so
+SudokuBoard::Grid bruteForceMinlex(const SudokuBoard::Grid& in) {
+    static constexpr int PERMS[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    SudokuBoard::Grid best;
+    best.fill(255);
+    std::array<int, 9> rows{};
+    std::array<int, 9> cols{};
+    for (int transpose = 0; transpose < 2; ++transpose) {
+        for (int r = 0; r < 6 * 6 * 6 * 6; ++r) {
+            for (int band = 0; band < 3; ++band) {
+                const int inner = (r / (band == 0 ? 6 : band == 1 ? 36 : 216)) % 6;
+                for (int i = 0; i < 3; ++i) rows[band * 3 + i] = PERMS[r % 6][band] * 3 + PERMS[inner][i];
+            }
+            for (int c = 0; c < 6 * 6 * 6 * 6; ++c) {
+                for (int stack = 0; stack < 3; ++stack) {
+                    const int inner = (c / (stack == 0 ? 6 : stack == 1 ? 36 : 216)) % 6;
+                    for (int i = 0; i < 3; ++i) cols[stack * 3 + i] = PERMS[c % 6][stack] * 3 + PERMS[inner][i];
+                }
+                std::array<std::uint8_t, 10> labels{};
+                std::uint8_t next = 1;
+                SudokuBoard::Grid image;
+                int order = 0;
+                for (int cell = 0; cell < SudokuBoard::CELLS && order <= 0; ++cell) {
+                    const int row = rows[cell / 9];
+                    const int col = cols[cell % 9];
+                    std::uint8_t value = transpose ? in[col * 9 + row] : in[row * 9 + col];
+                    if (value != 0) {
+                        if (labels[value] == 0) labels[value] = next++;
+                        value = labels[value];
+                    }
+                    image[cell] = value;
+                    if (order == 0 && value != best[cell]) order = value < best[cell] ? -1 : 1;
+                }
+                if (order < 0) best = image;
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+TEST(CanonicalizerTest, MatchesBruteForceMinlex) {
+    Canonicalizer canonicalizer;
+    for (const std::string& text : {HARD_PUZZLE, EASY_PUZZLE}) {
+        SudokuBoard::Grid puzzle = parse(text);
+        EXPECT_EQ(canonicalizer.canonicalize(puzzle), bruteForceMinlex(puzzle)) << text;
+    }
+}
+
+TEST(CanonicalizerTest, EquivalentPuzzlesShareOneForm) {
+    Canonicalizer canonicalizer;
+    SudokuBoard::Grid puzzle = parse(HARD_PUZZLE);
+    SudokuBoard::Grid solution = puzzle;
+    SearchSolver solver;
+    ASSERT_TRUE(solver.solve(solution));
+    const SudokuBoard::Grid form = canonicalizer.canonicalize(puzzle);
+    const SudokuBoard::Grid solution_form = canonicalizer.canonicalize(solution);
+
+    std::mt19937 rng(7);
+    for (int i = 0; i < 200; ++i) {
+        GridTransform transform = GridTransform::random(rng);
+        EXPECT_EQ(canonicalizer.canonicalize(transform.apply(puzzle)), form);
+        if (i % 20 == 0) {
+            EXPECT_EQ(canonicalizer.canonicalize(transform.apply(solution)), solution_form);
+        }
+    }
+
+    // a different puzzle lands elsewhere, and the form is a fixed point
+    EXPECT_NE(canonicalizer.canonicalize(parse(EASY_PUZZLE)), form);
+    EXPECT_EQ(canonicalizer.canonicalize(form), form);
+}
+
+TEST(CanonicalizerTest, HandlesHighlySymmetricGrids) {
+    Canonicalizer canonicalizer;
+    SudokuBoard::Grid empty{};
+    EXPECT_EQ(canonicalizer.canonicalize(empty), empty);
+
+    SudokuBoard::Grid single{};
+    single[40] = 7;
+    SudokuBoard::Grid expected{};
+    expected[80] = 1;                   // blank rows and columns sort first, so a lone clue ends up last
+    EXPECT_EQ(canonicalizer.canonicalize(single), expected);
+
+    // one clue per band and stack on the diagonal: every arrangement of them ties
+    SudokuBoard::Grid diagonal{};
+    diagonal[0] = 4;
+    diagonal[40] = 5;
+    diagonal[80] = 6;
+    EXPECT_EQ(canonicalizer.canonicalize(diagonal), bruteForceMinlex(diagonal));
+    EXPECT_GE(canonicalizer.getPeakStates(), 1u);
+}
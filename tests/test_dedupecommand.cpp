@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "DedupeCommand.hpp"
+#include "GridTransform.hpp"
+#include "PuzzleArchive.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+
+std::string toText(const SudokuBoard::Grid& grid) {
+    std::string text;
+    for (std::uint8_t value : grid) {
+        text.push_back(value == 0 ? '.' : static_cast<char>('0' + value));
+    }
+    return text;
+}
+
+// both puzzles, each followed by random symmetric copies of itself
+std::string library(int copies) {
+    std::mt19937 rng(11);
+    std::string text;
+    for (const std::string& puzzle : {HARD_PUZZLE, EASY_PUZZLE}) {
+        SudokuBoard::Grid grid{};
+        EXPECT_TRUE(PuzzleCorpus::parseText(puzzle, grid));
+        text += puzzle + "\n";
+        for (int i = 0; i < copies; ++i) {
+            text += toText(GridTransform::random(rng).apply(grid)) + "\n";
+        }
+    }
+    return text;
+}
+
+} // namespace
+
+TEST(CanonicalIndexTest, InsertReportsNewFingerprintsAcrossGrowth) {
+    CanonicalIndex index(4);
+    const std::size_t initial = index.capacity();
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        EXPECT_TRUE(index.insert(key * 0x9e3779b97f4a7c15ull));
+    }
+    EXPECT_GT(index.capacity(), initial);
+    EXPECT_EQ(index.size(), 1000u);
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        EXPECT_FALSE(index.insert(key * 0x9e3779b97f4a7c15ull));
+        EXPECT_TRUE(index.contains(key * 0x9e3779b97f4a7c15ull));
+    }
+    EXPECT_FALSE(index.contains(12345));
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_FALSE(index.contains(0));
+}
+
+TEST(DedupeCommandTest, Run_KeepsFirstOfEachSymmetryClass) {
+    std::istringstream in(library(20) + HARD_PUZZLE + "\n" + "123\n");
+    std::ostringstream out;
+    DedupeCommand command({});
+    auto streamed = command.run(in, out);
+    ASSERT_TRUE(streamed.has_value());
+    DedupeCommand::Report report = *streamed;
+
+    EXPECT_EQ(out.str(), HARD_PUZZLE + "\n" + EASY_PUZZLE + "\n");
+    EXPECT_EQ(report.puzzles, 44u);
+    EXPECT_EQ(report.unique, 2u);
+    EXPECT_EQ(report.duplicates, 41u);
+    EXPECT_EQ(report.invalid, 1u);
+
+    // only literal repeats count with --exact; --canonical writes the minlex forms
+    std::istringstream again(library(20) + HARD_PUZZLE + "\n");
+    std::ostringstream exact_out;
+    DedupeCommand exact({"-", true, true});
+    report = exact.run(again, exact_out).value();
+    EXPECT_EQ(report.duplicates, 1u);
+    Canonicalizer canonicalizer;
+    SudokuBoard::Grid grid{};
+    ASSERT_TRUE(PuzzleCorpus::parseText(HARD_PUZZLE, grid));
+    EXPECT_EQ(exact_out.str().substr(0, SudokuBoard::CELLS), toText(canonicalizer.canonicalize(grid)));
+}
+
+TEST(DedupeCommandTest, RunFile_PackedInputStaysPacked) {
+    const std::string path = ::testing::TempDir() + "dedupe_input.bin";
+    std::istringstream lines(library(5));
+    {
+        std::ofstream file(path, std::ios::binary);
+        PuzzleCorpus::writePackedHeader(file);
+        std::string line;
+        SudokuBoard::Grid grid{};
+        std::uint8_t record[PuzzleCorpus::PACKED_RECORD_SIZE];
+        while (std::getline(lines, line)) {
+            ASSERT_TRUE(PuzzleCorpus::parseText(line, grid));
+            PuzzleCorpus::pack(grid, record);
+            file.write(reinterpret_cast<const char*>(record), sizeof(record));
+        }
+    }
+
+    std::ostringstream out;
+    DedupeCommand command({path});
+    auto report = command.runFile(path, out);
+    ASSERT_TRUE(report.has_value());
+    EXPECT_EQ(report->unique, 2u);
+    EXPECT_EQ(report->duplicates, 10u);
+    EXPECT_EQ(out.str().size(), PuzzleCorpus::PACKED_HEADER_SIZE + 2 * PuzzleCorpus::PACKED_RECORD_SIZE);
+
+    // deduplicating the packed output again changes nothing
+    std::istringstream packed(out.str());
+    std::ostringstream again;
+    DedupeCommand reread({});
+    EXPECT_EQ(reread.run(packed, again).value().unique, 2u);
+    EXPECT_EQ(again.str(), out.str());
+    EXPECT_FALSE(command.runFile(path + ".missing", out).has_value());
+    std::remove(path.c_str());
+}
+
+TEST(DedupeCommandTest, Run_RefusesArchivesWithSolutions) {
+    PuzzleArchive::Entry entry;
+    ASSERT_TRUE(PuzzleCorpus::parseText(EASY_PUZZLE, entry.givens));
+    ASSERT_TRUE(PuzzleCorpus::parseText(
+        "534678912672195348198342567859761423426853791713924856961537284287419635345286179", entry.solution));
+    std::ostringstream archive;
+    ASSERT_TRUE(PuzzleArchive::write(archive, std::span(&entry, 1), true));
+
+    // packed output has no room for the solutions, so nothing is written
+    std::istringstream in(archive.str());
+    std::ostringstream out;
+    DedupeCommand command({});
+    EXPECT_FALSE(command.run(in, out).has_value());
+    EXPECT_TRUE(out.str().empty());
+
+    // so is a packed header of another version
+    std::string header = archive.str().substr(0, PuzzleCorpus::PACKED_HEADER_SIZE);
+    std::copy(std::begin(PuzzleCorpus::PACKED_MAGIC), std::end(PuzzleCorpus::PACKED_MAGIC), header.begin());
+    header[8] = 9;
+    std::istringstream unknown(header);
+    EXPECT_FALSE(command.run(unknown, out).has_value());
+    EXPECT_TRUE(out.str().empty());
+
+    const std::string path = ::testing::TempDir() + "dedupe_archive.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << archive.str();
+    }
+    EXPECT_FALSE(command.runFile(path, out).has_value());
+    EXPECT_TRUE(out.str().empty());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "DlxSolver.hpp"
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <string>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+
+SudokuBoard::Grid parseGrid(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        grid[i] = (text[i] >= '1' && text[i] <= '9') ? static_cast<std::uint8_t>(text[i] - '0') : 0;
+    }
+    return grid;
+}
+
+} // namespace
+
+TEST(DlxSolverTest, Solve_MatchesSearchSolverOnUniquePuzzles) {
+    DlxSolver dlx;
+    SearchSolver search;
+    for (const auto& text : {HARD_PUZZLE, EASY_PUZZLE}) {
+        SudokuBoard::Grid a = parseGrid(text);
+        SudokuBoard::Grid b = a;
+        ASSERT_TRUE(dlx.solve(a));
+        ASSERT_TRUE(search.solve(b));
+        EXPECT_EQ(a, b) << "Both engines must find the unique solution";
+    }
+}
+
+TEST(DlxSolverTest, Solve_ReusesNodeStorageAcrossSolves) {
+    DlxSolver dlx;
+    SudokuBoard::Grid first = parseGrid(HARD_PUZZLE);
+    ASSERT_TRUE(dlx.solve(first));
+
+    // a failed solve in between must also leave the matrix fully restored
+    SudokuBoard::Grid conflict{};
+    conflict[0] = 3;
+    conflict[10] = 3;   // same box
+    EXPECT_FALSE(dlx.solve(conflict));
+
+    SudokuBoard::Grid again = parseGrid(HARD_PUZZLE);
+    ASSERT_TRUE(dlx.solve(again));
+    EXPECT_EQ(first, again);
+}
+
+TEST(DlxSolverTest, Solve_EmptyGridWithRngFillsBoard) {
+    std::mt19937 rng(3);
+    DlxSolver dlx;
+    SudokuBoard::Grid grid{};
+    ASSERT_TRUE(dlx.solve(grid, &rng));
+    SudokuBoard board;
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        board.setCell(i / SudokuBoard::SIZE, i % SudokuBoard::SIZE, grid[i]);
+    }
+    EXPECT_TRUE(board.isFull());
+    EXPECT_TRUE(board.isValid());
+}
+
+TEST(DlxSolverTest, BoardApi_RunsOnDancingLinksEngine) {
+    std::mt19937 rng(11);
+    SudokuBoard board;
+    board.setSolverEngine(SudokuBoard::SolverEngine::DancingLinks);
+    ASSERT_TRUE(board.solveBoard(rng));
+    EXPECT_TRUE(board.isFull());
+    EXPECT_TRUE(board.isValid());
+    EXPECT_GT(board.getSolveStats().nodes, 0u);
+
+    EXPECT_EQ(board.removeCells(41, rng), 41);
+    EXPECT_TRUE(board.isValid());
+
+    int row = 0, col = 0;
+    while (board.getCell(row, col) != 0) {
+        if (++col == SudokuBoard::SIZE) { col = 0; ++row; }
+    }
+    auto hint = board.getHint(row, col, rng);
+    ASSERT_TRUE(hint.has_value());
+    EXPECT_TRUE(board.isValidMove(row, col, *hint));
+}
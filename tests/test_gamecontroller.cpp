@@ -17,7 +17,9 @@ public:
     // --- Mock State Variables (for assertions) ---
     std::string last_displayed_message;
     int flash_screen_call_count = 0;
-    std::vector<std::pair<int, int>> last_set_errors;
+    bool errors_shown = false;
+    std::string working;
+    int working_call_count = 0;
 
     // --- Add the displayDifficultyMenu mock implementation ---
     void displayDifficultyMenu(int selected_difficulty) const noexcept override {
@@ -63,8 +65,13 @@ public:
         selected_menu_item_ = item;
     }
 
-    void setErrors(const std::vector<std::pair<int, int>>& errors) noexcept override {
-        last_set_errors = errors;
+    void showErrors(bool show) noexcept override {
+        errors_shown = show;
+    }
+
+    void showWorking(const std::string& task) noexcept override {
+        working = task;
+        ++working_call_count;
     }
 
     std::pair<int, int> getCursorPosition() const noexcept override {
@@ -120,7 +127,8 @@ TEST_F(GameControllerTest, SubmitIncorrectBoard) {
     }
     simulateKeyPresses({'\t', '\n'});
     EXPECT_EQ(mock_ui_ptr->last_displayed_message, "Your mistakes are highlighted in red!");
-    EXPECT_FALSE(mock_ui_ptr->last_set_errors.empty());
+    EXPECT_TRUE(mock_ui_ptr->errors_shown);
+    EXPECT_FALSE(board.findErrors().empty());
     EXPECT_TRUE(controller->isRunning());
 }
 
@@ -149,6 +157,7 @@ TEST_F(GameControllerTest, UndoAction_NothingToUndo) {
 TEST_F(GameControllerTest, HintAction_Success) {
     ASSERT_EQ(board.getCell(0, 0), 0);
     simulateKeyPresses({'\t', KEY_DOWN, KEY_DOWN, '\n'});
+    controller->waitForTask();
     EXPECT_NE(board.getCell(0, 0), 0);
     EXPECT_EQ(mock_ui_ptr->last_displayed_message, "Hint provided! (1/3 used)");
 }
@@ -181,4 +190,97 @@ TEST_F(GameControllerTest, SelectDifficulty_NavigatesAndSelectsHardMode) {
     mock_ui_ptr->setKeySequence(key_presses);
     SudokuBoard::Difficulty selected_difficulty = controller->selectDifficulty();
     EXPECT_EQ(selected_difficulty, SudokuBoard::Difficulty::Hard);
-}
\ No newline at end of file
+}
+TEST_F(GameControllerTest, HintAction_SolvesInTheBackgroundAndShowsWorking) {
+    simulateKeyPresses({'\t', KEY_DOWN, KEY_DOWN, '\n'});
+    ASSERT_TRUE(controller->isBusy()) << "Without an answer key the hint needs a solve";
+    EXPECT_EQ(mock_ui_ptr->working, "Finding a hint");
+    EXPECT_EQ(board.getCell(0, 0), 0) << "Nothing changes until the result is applied";
+
+    controller->waitForTask();
+    EXPECT_FALSE(controller->isBusy());
+    EXPECT_EQ(mock_ui_ptr->working, "");
+    EXPECT_NE(board.getCell(0, 0), 0);
+    EXPECT_TRUE(board.hasConsistentSolution()) << "The background solve becomes the answer key";
+
+    // the next hint is a lookup in that key and needs no job
+    mock_ui_ptr->setFocus(FocusState::MENU);
+    mock_ui_ptr->setCursorPosition(4, 4);
+    simulateKeyPresses({'\n'});
+    EXPECT_FALSE(controller->isBusy());
+    EXPECT_NE(board.getCell(4, 4), 0);
+    EXPECT_EQ(mock_ui_ptr->last_displayed_message, "Hint provided! (2/3 used)");
+}
+
+TEST_F(GameControllerTest, HintAction_AnswersTheCellHoldingAWrongDigit) {
+    // the classic puzzle without its answer key; its solution starts 534678912
+    const char* text = "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+    SudokuBoard::Grid puzzle{};
+    for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+        puzzle[cell] = static_cast<std::uint8_t>(text[cell] - '0');
+    }
+    ASSERT_TRUE(board.loadPuzzle(puzzle));
+    ASSERT_TRUE(board.setCell(0, 2, 1));
+    ASSERT_TRUE(board.setCell(0, 3, 2));    // a second mistake, so only the givens can answer
+    mock_ui_ptr->setCursorPosition(0, 2);
+    simulateKeyPresses({'\t', KEY_DOWN, KEY_DOWN, '\n'});
+    ASSERT_TRUE(controller->isBusy());
+    controller->waitForTask();
+    EXPECT_EQ(mock_ui_ptr->last_displayed_message, "Hint provided! (1/3 used)");
+    EXPECT_EQ(board.getCell(0, 2), 4);
+    EXPECT_TRUE(board.hasAnswerKey());
+
+    // the key survives the other mistake, so the next hint needs no job
+    mock_ui_ptr->setCursorPosition(0, 3);
+    simulateKeyPresses({'\n'});
+    EXPECT_FALSE(controller->isBusy());
+    EXPECT_EQ(board.getCell(0, 3), 6);
+    EXPECT_EQ(mock_ui_ptr->last_displayed_message, "Hint provided! (2/3 used)");
+}
+
+TEST_F(GameControllerTest, BusyController_KeepsNavigationAndRefusesEdits) {
+    simulateKeyPresses({'\t', KEY_DOWN, KEY_DOWN, '\n'});
+    ASSERT_TRUE(controller->isBusy());
+    simulateKeyPresses({'\t', KEY_RIGHT, KEY_DOWN, '5'});
+    EXPECT_EQ(mock_ui_ptr->getFocus(), FocusState::BOARD);
+    EXPECT_EQ(mock_ui_ptr->getCursorPosition(), std::make_pair(1, 1));
+    EXPECT_EQ(board.getCell(1, 1), 0) << "Edits wait for the job";
+    EXPECT_EQ(mock_ui_ptr->flash_screen_call_count, 1);
+    EXPECT_TRUE(controller->isBusy());
+    EXPECT_TRUE(controller->isRunning());
+}
+
+TEST_F(GameControllerTest, CancelKey_DropsTheHint) {
+    simulateKeyPresses({'\t', KEY_DOWN, KEY_DOWN, '\n'});
+    ASSERT_TRUE(controller->isBusy());
+    simulateKeyPresses({GameController::CANCEL_KEY});
+    EXPECT_FALSE(controller->isBusy());
+    EXPECT_EQ(mock_ui_ptr->working, "");
+    EXPECT_EQ(mock_ui_ptr->last_displayed_message, "Cancelled.");
+    EXPECT_EQ(board.getCell(0, 0), 0);
+    EXPECT_EQ(board.getHintsUsed(), 0) << "A cancelled hint is not counted";
+
+    controller->pollTask();     // nothing left to apply
+    EXPECT_EQ(board.getCell(0, 0), 0);
+}
+
+TEST_F(GameControllerTest, NewGame_IsMadeInTheBackground) {
+    board.setCell(0, 0, 5);
+    simulateKeyPresses({'\t', KEY_UP, KEY_UP, '\n'});
+    ASSERT_TRUE(controller->isBusy());
+    EXPECT_EQ(mock_ui_ptr->working, "Making a puzzle");
+
+    controller->waitForTask();
+    EXPECT_EQ(mock_ui_ptr->last_displayed_message, "New Easy game started!");
+    EXPECT_EQ(mock_ui_ptr->getFocus(), FocusState::BOARD);
+    EXPECT_EQ(board.getFilledCount(), SudokuBoard::CELLS - SudokuBoard::removalTarget(SudokuBoard::Difficulty::Easy));
+    EXPECT_TRUE(board.hasConsistentSolution());
+}
+
+TEST_F(GameControllerTest, QuitWhileBusy_CancelsTheJob) {
+    simulateKeyPresses({'\t', KEY_UP, KEY_UP, '\n'});
+    ASSERT_TRUE(controller->isBusy());
+    simulateKeyPresses({'q'});
+    EXPECT_FALSE(controller->isBusy());
+    EXPECT_FALSE(controller->isRunning());
+}
@@ -2,6 +2,9 @@
 #include <ncurses.h> 
 #include "GameUI.hpp"
 #include "SudokuBoard.hpp"
+#include <cstdio>
+#include <memory>
+#include <sys/stat.h>
 
 class MockGameUI : public GameUI {
 public:
@@ -84,7 +87,7 @@ protected:
 };
 
 TEST_F(GameUITest, Constructor_InitializesBoardReference) {
-    EXPECT_EQ(&ui.getBoard(), &board.getBoard());
+    EXPECT_EQ(ui.getBoard().data(), board.getBoard().data());
 }
 
 TEST_F(GameUITest, Constructor_InitializesUIState) {
@@ -171,4 +174,98 @@ TEST_F(GameUITest, HandleInput_MenuNavigation) {
     
     ui.simulateKeyPress(KEY_DOWN);
     EXPECT_EQ(ui.getSelectedMenuItem(), 0);
-}
\ No newline at end of file
+}
+// Draws to a temporary file instead of the terminal, so the bytes each frame costs can be counted.
+class FileGameUI : public GameUI {
+public:
+    FileGameUI(SudokuBoard& board, FILE* out, FILE* in) : GameUI(board, out, in, "xterm") {}
+
+    char cellOnScreen(int row, int col) const {
+        return static_cast<char>(mvwinch(board_win_, row * CELL_HEIGHT + 1, col * CELL_WIDTH + 2) & A_CHARTEXT);
+    }
+};
+
+class GameUIRenderTest : public ::testing::Test {
+protected:
+    SudokuBoard board;
+    FILE* out = std::tmpfile();
+    FILE* in = std::fopen("/dev/null", "r");
+    std::unique_ptr<FileGameUI> ui;
+
+    void SetUp() override {
+        ASSERT_NE(out, nullptr);
+        ASSERT_NE(in, nullptr);
+        ui = std::make_unique<FileGameUI>(board, out, in);
+    }
+
+    void TearDown() override {
+        ui.reset();
+        std::fclose(out);
+        std::fclose(in);
+    }
+
+    long written() {
+        std::fflush(out);
+        struct stat info {};
+        fstat(fileno(out), &info);
+        return static_cast<long>(info.st_size);
+    }
+
+    long frameBytes() {
+        const long before = written();
+        ui->displayBoard();
+        return written() - before;
+    }
+};
+
+TEST_F(GameUIRenderTest, UnchangedFrame_WritesNothing) {
+    const long first = frameBytes();
+    EXPECT_GT(first, 500) << "The first frame draws the whole layout";
+    EXPECT_EQ(frameBytes(), 0);
+}
+
+TEST_F(GameUIRenderTest, CursorMove_RewritesOnlyTwoCells) {
+    const long first = frameBytes();
+    ui->setCursorPosition(0, 1);
+    const long moved = frameBytes();
+    EXPECT_GT(moved, 0);
+    EXPECT_LT(moved, 128) << "Only the old and the new cursor cell change";
+    EXPECT_LT(moved * 50, first);
+}
+
+TEST_F(GameUIRenderTest, ChangedCells_AreRedrawnInPlace) {
+    frameBytes();
+    board.setCell(4, 4, 7);
+    board.setCell(8, 8, 3);
+    EXPECT_GT(frameBytes(), 0);
+    EXPECT_EQ(ui->cellOnScreen(4, 4), '7');
+    EXPECT_EQ(ui->cellOnScreen(8, 8), '3');
+    EXPECT_EQ(ui->cellOnScreen(0, 0), '.');
+
+    board.setCell(4, 4, 0);
+    frameBytes();
+    EXPECT_EQ(ui->cellOnScreen(4, 4), '.');
+}
+
+TEST_F(GameUIRenderTest, MenuAndWorkingNote_OnlyTheirLinesChange) {
+    const long first = frameBytes();
+    ui->setFocus(FocusState::MENU);
+    ui->setSelectedMenuItem(2);
+    const long menu = frameBytes();
+    EXPECT_GT(menu, 0);
+    EXPECT_LT(menu * 4, first) << "Cursor cell and one menu line";
+
+    ui->showWorking("Finding a hint");
+    const long working = frameBytes();
+    EXPECT_GT(working, 0);
+    EXPECT_LT(working * 4, first);
+    ui->showWorking("");
+    EXPECT_GT(frameBytes(), 0) << "Clearing the note blanks its lines";
+    EXPECT_EQ(frameBytes(), 0);
+}
+
+TEST_F(GameUIRenderTest, FullScreenPage_ForcesAFullFrame) {
+    const long first = frameBytes();
+    ui->displayDifficultyMenu(0);
+    EXPECT_GT(frameBytes() * 2, first) << "The difficulty page covered the layout";
+}
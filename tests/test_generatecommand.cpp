@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "GenerateCommand.hpp"
+#include "PuzzleCorpus.hpp"
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+
+GenerateCommand::Options smallRun(std::size_t count) {
+    GenerateCommand::Options options;
+    options.count = count;
+    options.difficulty = SudokuBoard::Difficulty::Easy;
+    options.threads = {1, 2, 1, 1};
+    options.queue_capacity = 4;     // small enough that backpressure actually happens
+    options.seed = 42;
+    return options;
+}
+
+} // namespace
+
+TEST(GenerateCommandTest, Rate_GradesByTechniqueNeeded) {
+    SudokuBoard::Grid grid{};
+    ASSERT_TRUE(PuzzleCorpus::parseText(EASY_PUZZLE, grid));
+    EXPECT_EQ(GenerateCommand::rate(grid), SudokuBoard::Difficulty::Easy);
+    ASSERT_TRUE(PuzzleCorpus::parseText(HARD_PUZZLE, grid));
+    EXPECT_EQ(GenerateCommand::rate(grid), SudokuBoard::Difficulty::Hard);
+}
+
+TEST(GenerateCommandTest, Run_WritesRequestedCountOfDistinctUniquePuzzles) {
+    std::ostringstream out;
+    GenerateCommand generator(smallRun(25));
+    GenerateCommand::Report report = generator.run(out);
+
+    EXPECT_EQ(report.written, 25u);
+    EXPECT_EQ(report.ratings[0] + report.ratings[1] + report.ratings[2], 25u);
+
+    std::istringstream lines(out.str());
+    std::set<std::string> distinct;
+    std::string line;
+    while (std::getline(lines, line)) {
+        SudokuBoard::Grid grid{};
+        ASSERT_TRUE(PuzzleCorpus::parseText(line, grid)) << line;
+        SudokuBoard board;
+        ASSERT_TRUE(board.loadPuzzle(grid));
+        EXPECT_EQ(board.countSolutions(2), 1) << line;
+        EXPECT_GE(board.getFilledCount(), SudokuBoard::CELLS - SudokuBoard::removalTarget(SudokuBoard::Difficulty::Easy));
+        distinct.insert(line);
+    }
+    EXPECT_EQ(distinct.size(), 25u);
+
+    // every stage saw at least what was written, and the report describes the configuration
+    for (int stage = 0; stage < GenerateCommand::STAGES; ++stage) {
+        EXPECT_GE(report.stages[stage].items, 25u) << "stage " << stage;
+    }
+    EXPECT_EQ(report.stages[GenerateCommand::DIG].threads, 2u);
+    EXPECT_EQ(report.queues[0].capacity, 4u);
+    EXPECT_LE(report.queues[0].max, 4u);
+}
+
+TEST(GenerateCommandTest, Run_PackedOutputReadsBackAsCorpus) {
+    GenerateCommand::Options options = smallRun(5);
+    options.packed = true;
+    std::ostringstream out;
+    GenerateCommand(options).run(out);
+
+    std::string data = out.str();
+    PuzzleCorpus::Format format{};
+    std::size_t header = 0;
+    ASSERT_TRUE(PuzzleCorpus::detectFormat(data, format, header));
+    EXPECT_EQ(format, PuzzleCorpus::Format::Packed);
+    EXPECT_EQ(data.size(), header + 5 * PuzzleCorpus::PACKED_RECORD_SIZE);
+}
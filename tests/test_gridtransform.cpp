@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "GridTransform.hpp"
+#include "SearchSolver.hpp"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <string>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+
+SudokuBoard::Grid parse(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        grid[i] = text[i] == '.' ? 0 : static_cast<std::uint8_t>(text[i] - '0');
+    }
+    return grid;
+}
+
+bool isValidFull(const SudokuBoard::Grid& grid) {
+    SudokuBoard board;
+    board.loadPuzzle(grid);
+    return board.isFull() && board.isValid();
+}
+
+} // namespace
+
+TEST(GridTransformTest, Identity_LeavesGridUnchanged) {
+    SudokuBoard::Grid puzzle = parse(HARD_PUZZLE);
+    EXPECT_EQ(GridTransform().apply(puzzle), puzzle);
+}
+
+TEST(GridTransformTest, RandomTransforms_KeepSolutionsAndCluesMatched) {
+    SudokuBoard::Grid puzzle = parse(HARD_PUZZLE);
+    SudokuBoard::Grid solution = puzzle;
+    SearchSolver solver;
+    ASSERT_TRUE(solver.solve(solution));
+    const auto clues = std::count_if(puzzle.begin(), puzzle.end(), [](std::uint8_t v) { return v != 0; });
+
+    std::mt19937 rng(2024);
+    std::set<SudokuBoard::Grid> images;
+    for (int i = 0; i < 50; ++i) {
+        GridTransform transform = GridTransform::random(rng);
+        SudokuBoard::Grid image = transform.apply(puzzle);
+        SudokuBoard::Grid image_solution = transform.apply(solution);
+
+        EXPECT_TRUE(isValidFull(image_solution));
+        EXPECT_EQ(std::count_if(image.begin(), image.end(), [](std::uint8_t v) { return v != 0; }), clues);
+        for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+            if (image[cell] != 0) {
+                ASSERT_EQ(image[cell], image_solution[cell]) << "clue moved away from its answer";
+            }
+        }
+
+        // the image is still unique, and its one solution is the transformed solution
+        SudokuBoard::Grid solved = image;
+        ASSERT_TRUE(solver.solve(solved));
+        EXPECT_EQ(solved, image_solution);
+        EXPECT_EQ(solver.countSolutions(image, 2), 1);
+        images.insert(image);
+    }
+    EXPECT_GT(images.size(), 45u) << "random transforms should rarely repeat";
+}
+
+TEST(GridTransformTest, FromParts_TransposeAndRelabel) {
+    std::array<std::uint8_t, SudokuBoard::SIZE> lines{};
+    std::iota(lines.begin(), lines.end(), 0);
+    std::array<std::uint8_t, SudokuBoard::SIZE + 1> digits{};
+    std::iota(digits.begin(), digits.end(), 0);
+    std::swap(digits[1], digits[2]);
+
+    SudokuBoard::Grid puzzle = parse(HARD_PUZZLE);
+    SudokuBoard::Grid image = GridTransform::fromParts(lines, lines, true, digits).apply(puzzle);
+    for (int row = 0; row < SudokuBoard::SIZE; ++row) {
+        for (int col = 0; col < SudokuBoard::SIZE; ++col) {
+            int value = puzzle[col * SudokuBoard::SIZE + row];
+            int expected = value == 1 ? 2 : value == 2 ? 1 : value;
+            EXPECT_EQ(image[row * SudokuBoard::SIZE + col], expected);
+        }
+    }
+}
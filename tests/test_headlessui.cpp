@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <ncurses.h>
+#include "GameController.hpp"
+#include "HeadlessUI.hpp"
+#include "SudokuBoard.hpp"
+#include <memory>
+#include <vector>
+
+TEST(HeadlessUITest, DisplayBoard_RecordsTheFrame) {
+    SudokuBoard board;
+    board.setCell(0, 0, 5);
+    board.setCell(0, 1, 5);
+    HeadlessUI ui(board);
+    ui.setCursorPosition(2, 3);
+    ui.showErrors(true);
+    ui.showWorking("Finding a hint");
+    ui.displayBoard();
+
+    const HeadlessUI::Frame& frame = ui.getFrame();
+    EXPECT_EQ(frame.text().substr(0, 10), "55.......\n");
+    EXPECT_TRUE(frame.errors[0]);
+    EXPECT_TRUE(frame.errors[1]);
+    EXPECT_FALSE(frame.errors[2]);
+    EXPECT_EQ(frame.cursor_row, 2);
+    EXPECT_EQ(frame.cursor_col, 3);
+    EXPECT_EQ(frame.working, "Finding a hint");
+    EXPECT_EQ(ui.getCounters().frames, 1u);
+
+    board.setCell(0, 1, 0);
+    EXPECT_EQ(ui.getFrame().cells[1], '5') << "The frame only changes when one is displayed";
+    ui.displayBoard();
+    EXPECT_EQ(ui.getFrame().cells[1], '.');
+}
+
+TEST(HeadlessUITest, KeyScripts_ParseAndFormat) {
+    std::vector<int> keys;
+    ASSERT_TRUE(HeadlessUI::parseKeys("RIGHT 5 # comment, ignored\nTAB DOWN ENTER ESC 0 BACKSPACE q", keys));
+    const std::vector<int> expected = {KEY_RIGHT, '5', '\t', KEY_DOWN, '\n', 27, '0', KEY_BACKSPACE, 'q'};
+    EXPECT_EQ(keys, expected);
+    EXPECT_EQ(HeadlessUI::formatKeys(keys), "RIGHT 5 TAB DOWN ENTER ESC 0 BACKSPACE q");
+
+    std::vector<int> again;
+    ASSERT_TRUE(HeadlessUI::parseKeys(HeadlessUI::formatKeys(keys).value(), again));
+    EXPECT_EQ(again, keys);
+
+    std::vector<int> bad;
+    EXPECT_FALSE(HeadlessUI::parseKeys("UP SIDEWAYS", bad));
+    EXPECT_FALSE(HeadlessUI::parseKeys("\\12x", bad));
+    EXPECT_FALSE(HeadlessUI::parseKeys("\\100000", bad));
+}
+
+TEST(HeadlessUITest, KeyScripts_RoundTripKeysThatNeedEscaping) {
+    // '#' would start a comment, a space would vanish between tokens, and the rest are not chars
+    const std::vector<int> keys = {'#', ' ', KEY_DC, 127, '\r', 0, ERR, '\\', KEY_F(1), KEY_MAX};
+    auto text = HeadlessUI::formatKeys(keys);
+    ASSERT_TRUE(text.has_value());
+    std::vector<int> parsed;
+    ASSERT_TRUE(HeadlessUI::parseKeys(*text, parsed)) << *text;
+    EXPECT_EQ(parsed, keys) << *text;
+
+    EXPECT_FALSE(HeadlessUI::formatKeys(std::vector<int>{'q', KEY_MAX + 1}).has_value());
+    EXPECT_FALSE(HeadlessUI::formatKeys(std::vector<int>{-2}).has_value());
+}
+
+TEST(HeadlessUITest, Script_RunsAWholeGameWithoutATerminal) {
+    SudokuBoard board;
+    auto owned = std::make_unique<HeadlessUI>(board);
+    HeadlessUI& ui = *owned;
+    std::vector<int> keys;
+    // pick Easy, step right, ask for a hint through the menu, then quit; a generated puzzle
+    // carries its answer key, so the hint is applied at once
+    ASSERT_TRUE(HeadlessUI::parseKeys("ENTER RIGHT TAB DOWN DOWN ENTER TAB q", keys));
+    ui.setKeys(keys);
+    GameController controller(board, std::move(owned));
+    controller.run();
+
+    EXPECT_FALSE(controller.isRunning());
+    EXPECT_FALSE(ui.hasKeys());
+    EXPECT_EQ(ui.getCounters().difficulty_menus, 1u);
+    EXPECT_EQ(ui.getCounters().frames, keys.size() - 1) << "One frame before each key of the game loop";
+    EXPECT_EQ(ui.getFrame().cursor_col, 1);
+    EXPECT_EQ(ui.getFrame().focus, FocusState::BOARD);
+    EXPECT_EQ(board.getFilledCount(), SudokuBoard::CELLS - SudokuBoard::removalTarget(SudokuBoard::Difficulty::Easy)
+                                          + (board.isPreFilled(0, 1) ? 0 : 1));
+    EXPECT_FALSE(ui.getLastMessage().empty());
+}
+
+TEST(HeadlessUITest, GetPressedKey_ReturnsErrOnceTheScriptIsUsedUp) {
+    SudokuBoard board;
+    HeadlessUI ui(board);
+    ui.setKeys({'7'});
+    EXPECT_EQ(ui.getPressedKey(), '7');
+    EXPECT_EQ(ui.getPressedKey(), ERR);
+    EXPECT_FALSE(ui.hasKeys());
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "ParallelSolver.hpp"
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <string>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+
+SudokuBoard::Grid parseGrid(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        grid[i] = (text[i] >= '1' && text[i] <= '9') ? static_cast<std::uint8_t>(text[i] - '0') : 0;
+    }
+    return grid;
+}
+
+} // namespace
+
+TEST(ParallelSolverTest, Solve_MatchesSearchSolverOnUniquePuzzles) {
+    ParallelSolver parallel(4);
+    SearchSolver search;
+    for (const auto& text : {HARD_PUZZLE, EASY_PUZZLE}) {
+        SudokuBoard::Grid a = parseGrid(text);
+        SudokuBoard::Grid b = a;
+        ASSERT_TRUE(parallel.solve(a));
+        ASSERT_TRUE(search.solve(b));
+        EXPECT_EQ(a, b) << "Both engines must find the unique solution";
+    }
+}
+
+TEST(ParallelSolverTest, Solve_HardPuzzleIsSplitIntoTasks) {
+    ParallelSolver parallel(4);
+    SudokuBoard::Grid grid = parseGrid(HARD_PUZZLE);
+    ASSERT_TRUE(parallel.solve(grid));
+    EXPECT_GT(parallel.getStats().tasks, 1u) << "Propagation cannot finish this one, so the root must split";
+}
+
+TEST(ParallelSolverTest, Solve_RejectsContradictoryGrid) {
+    ParallelSolver parallel(3);
+    SudokuBoard::Grid grid = parseGrid(HARD_PUZZLE);
+    grid[1] = 1;    // duplicate of the given in cell 0
+    SudokuBoard::Grid before = grid;
+    EXPECT_FALSE(parallel.solve(grid));
+    EXPECT_EQ(grid, before);
+}
+
+TEST(ParallelSolverTest, CountSolutions_SumsWorkerCountsAndStopsAtLimit) {
+    ParallelSolver parallel(4);
+    SearchSolver search;
+
+    SudokuBoard::Grid empty{};
+    EXPECT_EQ(parallel.countSolutions(empty, 500), 500);
+
+    // strip a few givens so the count is small but above one
+    SudokuBoard::Grid loose = parseGrid(HARD_PUZZLE);
+    int removed = 0;
+    for (auto& cell : loose) {
+        if (cell != 0 && removed < 4) {
+            cell = 0;
+            ++removed;
+        }
+    }
+    int expected = search.countSolutions(loose, 100000);
+    ASSERT_GT(expected, 1);
+    EXPECT_EQ(parallel.countSolutions(loose, 100000), expected);
+    EXPECT_EQ(parallel.countSolutions(parseGrid(HARD_PUZZLE), 2), 1);
+}
+
+TEST(ParallelSolverTest, Board_ParallelEngineSolvesAndCounts) {
+    SudokuBoard board;
+    board.setSolverEngine(SudokuBoard::SolverEngine::Parallel);
+    std::mt19937 rng(7);
+    ASSERT_TRUE(board.solveBoard(rng));
+    EXPECT_TRUE(board.isFull());
+    EXPECT_TRUE(board.isValid());
+    EXPECT_EQ(board.countSolutions(), 1);
+}
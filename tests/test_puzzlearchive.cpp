@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "PuzzleArchive.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Difficulty = SudokuBoard::Difficulty;
+
+const std::string EASY_PUZZLE =
+    "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+const std::string EASY_SOLUTION =
+    "534678912672195348198342567859761423426853791713924856961537284287419635345286179";
+
+std::string tempPath(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+SudokuBoard::Grid parse(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    EXPECT_TRUE(PuzzleCorpus::parseText(text, grid));
+    return grid;
+}
+
+// the easy puzzle with `extra` more of its solution's cells filled in, so every entry differs
+PuzzleArchive::Entry entry(Difficulty difficulty, int extra) {
+    PuzzleArchive::Entry result{difficulty, parse(EASY_PUZZLE), parse(EASY_SOLUTION)};
+    for (int cell = 0; extra > 0 && cell < SudokuBoard::CELLS; ++cell) {
+        if (result.givens[cell] == 0) {
+            result.givens[cell] = result.solution[cell];
+            --extra;
+        }
+    }
+    return result;
+}
+
+std::vector<PuzzleArchive::Entry> mixedEntries() {
+    return {entry(Difficulty::Hard, 0), entry(Difficulty::Easy, 1), entry(Difficulty::Hard, 2),
+            entry(Difficulty::Medium, 3), entry(Difficulty::Easy, 4)};
+}
+
+} // namespace
+
+TEST(PuzzleArchiveTest, WriteAndOpen_GroupsByDifficultyWithRandomAccess) {
+    const std::string path = tempPath("archive_solved.sar");
+    const auto entries = mixedEntries();
+    ASSERT_TRUE(PuzzleArchive::write(path, entries, true));
+
+    PuzzleArchive archive;
+    ASSERT_TRUE(archive.open(path));
+    EXPECT_TRUE(archive.hasSolutions());
+    EXPECT_EQ(archive.size(), 5u);
+    EXPECT_EQ(archive.size(Difficulty::Easy), 2u);
+    EXPECT_EQ(archive.size(Difficulty::Medium), 1u);
+    EXPECT_EQ(archive.size(Difficulty::Hard), 2u);
+
+    // groups keep input order
+    SudokuBoard::Grid givens{};
+    SudokuBoard::Grid solution{};
+    ASSERT_TRUE(archive.read(Difficulty::Hard, 1, givens, &solution));
+    EXPECT_EQ(givens, entries[2].givens);
+    EXPECT_EQ(solution, entries[2].solution);
+    EXPECT_FALSE(archive.read(Difficulty::Medium, 1, givens));
+
+    // file order is Easy, Medium, Hard
+    Difficulty difficulty{};
+    ASSERT_TRUE(archive.read(2, difficulty, givens));
+    EXPECT_EQ(difficulty, Difficulty::Medium);
+    EXPECT_EQ(givens, entries[3].givens);
+    EXPECT_FALSE(archive.read(5, difficulty, givens));
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    EXPECT_EQ(static_cast<std::size_t>(file.tellg()),
+              PuzzleCorpus::ARCHIVE_HEADER_SIZE + 5 * PuzzleCorpus::SOLVED_RECORD_SIZE);
+    std::remove(path.c_str());
+}
+
+TEST(PuzzleArchiveTest, GivensOnly_TakesOnePackedRecordPerPuzzle) {
+    const std::string path = tempPath("archive_givens.sar");
+    const auto entries = mixedEntries();
+    ASSERT_TRUE(PuzzleArchive::write(path, entries, false));
+
+    PuzzleArchive archive;
+    ASSERT_TRUE(archive.open(path));
+    EXPECT_FALSE(archive.hasSolutions());
+    SudokuBoard::Grid givens{};
+    SudokuBoard::Grid solution{};
+    ASSERT_TRUE(archive.read(Difficulty::Easy, 1, givens, &solution));
+    EXPECT_EQ(givens, entries[4].givens);
+    EXPECT_EQ(solution, SudokuBoard::Grid{});      // untouched
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    EXPECT_EQ(static_cast<std::size_t>(file.tellg()),
+              PuzzleCorpus::ARCHIVE_HEADER_SIZE + 5 * PuzzleCorpus::PACKED_RECORD_SIZE);
+    std::remove(path.c_str());
+}
+
+TEST(PuzzleArchiveTest, Corpus_ScansArchiveRecordsInFileOrder) {
+    const std::string path = tempPath("archive_corpus.sar");
+    const auto entries = mixedEntries();
+    ASSERT_TRUE(PuzzleArchive::write(path, entries, true));
+
+    PuzzleCorpus corpus;
+    ASSERT_TRUE(corpus.open(path));
+    EXPECT_EQ(corpus.getFormat(), PuzzleCorpus::Format::PackedSolved);
+    std::vector<SudokuBoard::Grid> seen;
+    PuzzleCorpus::forEachRecord(corpus.records(), corpus.getFormat(),
+                                [&](const SudokuBoard::Grid& grid, bool ok, std::string_view) {
+                                    EXPECT_TRUE(ok);
+                                    seen.push_back(grid);
+                                });
+    const std::vector<SudokuBoard::Grid> expected = {entries[1].givens, entries[4].givens, entries[3].givens,
+                                                     entries[0].givens, entries[2].givens};
+    EXPECT_EQ(seen, expected);
+    std::remove(path.c_str());
+}
+
+TEST(PuzzleArchiveTest, Open_RejectsOtherFilesAndBrokenIndex) {
+    const std::string path = tempPath("archive_broken.sar");
+    PuzzleArchive archive;
+    {
+        std::ofstream packed(path, std::ios::binary);
+        PuzzleCorpus::writePackedHeader(packed);
+    }
+    EXPECT_FALSE(archive.open(path));       // a plain packed corpus has no index
+
+    ASSERT_TRUE(PuzzleArchive::write(path, mixedEntries(), true));
+    {
+        // drop the last record: the index now points past the end of the file
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        bytes.resize(bytes.size() - PuzzleCorpus::SOLVED_RECORD_SIZE);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << bytes;
+    }
+    EXPECT_FALSE(archive.open(path));
+    EXPECT_FALSE(archive.isOpen());
+    EXPECT_FALSE(archive.open(tempPath("missing.sar")));
+    std::remove(path.c_str());
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "PuzzleCorpus.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+
+std::string tempPath(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+} // namespace
+
+TEST(PuzzleCorpusTest, ParseText_AcceptsDotsAndZerosOnly) {
+    SudokuBoard::Grid grid{};
+    EXPECT_TRUE(PuzzleCorpus::parseText(HARD_PUZZLE, grid));
+    EXPECT_EQ(grid[0], 1);
+    EXPECT_EQ(grid[1], 0);
+    EXPECT_TRUE(PuzzleCorpus::parseText(EASY_PUZZLE + "\r", grid));
+    EXPECT_FALSE(PuzzleCorpus::parseText(HARD_PUZZLE.substr(1), grid));
+    std::string bad = HARD_PUZZLE;
+    bad[3] = 'x';
+    EXPECT_FALSE(PuzzleCorpus::parseText(bad, grid));
+}
+
+TEST(PuzzleCorpusTest, Pack_RoundTripsInFortyOneBytes) {
+    SudokuBoard::Grid grid{};
+    ASSERT_TRUE(PuzzleCorpus::parseText(HARD_PUZZLE, grid));
+    std::uint8_t record[PuzzleCorpus::PACKED_RECORD_SIZE];
+    PuzzleCorpus::pack(grid, record);
+    SudokuBoard::Grid back{};
+    ASSERT_TRUE(PuzzleCorpus::unpack(record, back));
+    EXPECT_EQ(back, grid);
+    EXPECT_EQ(PuzzleCorpus::PACKED_RECORD_SIZE, 41u);
+
+    record[5] = 0xF0;   // nibble 15 is not a digit
+    EXPECT_FALSE(PuzzleCorpus::unpack(record, back));
+}
+
+TEST(PuzzleCorpusTest, RecordBoundary_LandsJustPastANewline) {
+    const std::string text = HARD_PUZZLE + "\n" + EASY_PUZZLE + "\n";
+    std::span<const char> data(text.data(), text.size());
+    EXPECT_EQ(PuzzleCorpus::recordBoundary(data, 0, PuzzleCorpus::Format::Text), 0u);
+    EXPECT_EQ(PuzzleCorpus::recordBoundary(data, 10, PuzzleCorpus::Format::Text), 82u);
+    EXPECT_EQ(PuzzleCorpus::recordBoundary(data, 82, PuzzleCorpus::Format::Text), 82u);
+    EXPECT_EQ(PuzzleCorpus::recordBoundary(data, 83, PuzzleCorpus::Format::Text), text.size());
+    EXPECT_EQ(PuzzleCorpus::recordBoundary(data, 50, PuzzleCorpus::Format::Packed), 82u);
+}
+
+TEST(PuzzleCorpusTest, Open_MapsTextAndPackedFiles) {
+    const std::string text_path = tempPath("corpus.txt");
+    const std::string packed_path = tempPath("corpus.bin");
+    {
+        std::ofstream text(text_path);
+        text << HARD_PUZZLE << "\r\n\n" << "garbage\n" << EASY_PUZZLE;     // no final newline
+        std::ofstream packed(packed_path, std::ios::binary);
+        PuzzleCorpus::writePackedHeader(packed);
+        for (const auto& puzzle : {HARD_PUZZLE, EASY_PUZZLE}) {
+            SudokuBoard::Grid grid{};
+            ASSERT_TRUE(PuzzleCorpus::parseText(puzzle, grid));
+            std::uint8_t record[PuzzleCorpus::PACKED_RECORD_SIZE];
+            PuzzleCorpus::pack(grid, record);
+            packed.write(reinterpret_cast<const char*>(record), sizeof(record));
+        }
+    }
+
+    std::vector<SudokuBoard::Grid> from_text;
+    std::vector<bool> ok_text;
+    PuzzleCorpus corpus;
+    ASSERT_TRUE(corpus.open(text_path));
+    EXPECT_EQ(corpus.getFormat(), PuzzleCorpus::Format::Text);
+    PuzzleCorpus::forEachRecord(corpus.records(), corpus.getFormat(),
+                                [&](const SudokuBoard::Grid& grid, bool ok, std::string_view) {
+        from_text.push_back(grid);
+        ok_text.push_back(ok);
+    });
+    ASSERT_EQ(from_text.size(), 3u) << "Blank lines are skipped, malformed ones reported";
+    EXPECT_EQ(ok_text, (std::vector<bool>{true, false, true}));
+
+    std::vector<SudokuBoard::Grid> from_packed;
+    ASSERT_TRUE(corpus.open(packed_path));
+    EXPECT_EQ(corpus.getFormat(), PuzzleCorpus::Format::Packed);
+    EXPECT_EQ(corpus.records().size(), 2 * PuzzleCorpus::PACKED_RECORD_SIZE);
+    PuzzleCorpus::forEachRecord(corpus.records(), corpus.getFormat(),
+                                [&](const SudokuBoard::Grid& grid, bool ok, std::string_view) {
+        EXPECT_TRUE(ok);
+        from_packed.push_back(grid);
+    });
+    ASSERT_EQ(from_packed.size(), 2u);
+    EXPECT_EQ(from_packed[0], from_text[0]);
+    EXPECT_EQ(from_packed[1], from_text[2]);
+
+    EXPECT_FALSE(corpus.open(tempPath("does-not-exist.txt")));
+    std::remove(text_path.c_str());
+    std::remove(packed_path.c_str());
+}
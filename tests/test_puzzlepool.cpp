@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "PuzzlePool.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Difficulty = SudokuBoard::Difficulty;
+
+std::string tempPath(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+// poll until the refill thread brings every difficulty up to count
+bool waitForStock(const PuzzlePool& pool, std::size_t count) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (pool.size(Difficulty::Easy) >= count && pool.size(Difficulty::Medium) >= count &&
+            pool.size(Difficulty::Hard) >= count) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(PuzzlePoolTest, Generate_StoresUniquePuzzleWithItsSolution) {
+    PuzzlePool::Puzzle puzzle = PuzzlePool::generate(Difficulty::Medium);
+    SudokuBoard board;
+    ASSERT_TRUE(board.loadPuzzle(puzzle.givens, &puzzle.solution));
+    EXPECT_EQ(board.countSolutions(2), 1);
+    EXPECT_TRUE(board.hasConsistentSolution());
+    for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+        if (puzzle.givens[cell] != 0) {
+            EXPECT_EQ(puzzle.givens[cell], puzzle.solution[cell]);
+            EXPECT_TRUE(board.isPreFilled(cell / SudokuBoard::SIZE, cell % SudokuBoard::SIZE));
+        }
+    }
+}
+
+TEST(PuzzlePoolTest, RefillThread_FillsToHighWatermarkAndRefillsBelowLow) {
+    PuzzlePool pool({1, 2});
+    pool.start();
+    ASSERT_TRUE(waitForStock(pool, 2));
+
+    // one take leaves the pool at the low watermark, which is not below it, so no refill
+    SudokuBoard board;
+    pool.take(Difficulty::Hard, board);
+    EXPECT_FALSE(board.isFull());
+    EXPECT_TRUE(board.hasConsistentSolution());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(pool.size(Difficulty::Hard), 1u);
+
+    // a second take drops below it and the pool climbs back to the high watermark
+    pool.take(Difficulty::Hard, board);
+    ASSERT_TRUE(waitForStock(pool, 2));
+    pool.stop();
+    EXPECT_EQ(pool.size(Difficulty::Hard), 2u);
+}
+
+TEST(PuzzlePoolTest, Take_FromEmptyPoolGeneratesOnCaller) {
+    PuzzlePool pool;    // never started
+    SudokuBoard board;
+    pool.take(Difficulty::Easy, board);
+    EXPECT_EQ(board.countSolutions(2), 1);
+    EXPECT_EQ(pool.size(Difficulty::Easy), 0u);
+}
+
+TEST(PuzzlePoolTest, SaveAndLoad_RoundTripPerDifficulty) {
+    PuzzlePool pool({1, 3});
+    PuzzlePool::Puzzle easy = PuzzlePool::generate(Difficulty::Easy);
+    PuzzlePool::Puzzle hard = PuzzlePool::generate(Difficulty::Hard);
+    pool.add(Difficulty::Easy, easy);
+    pool.add(Difficulty::Hard, hard);
+    pool.add(Difficulty::Hard, hard);
+
+    const std::string path = tempPath("pool.bin");
+    ASSERT_TRUE(pool.save(path));
+
+    PuzzlePool restored({1, 3});
+    ASSERT_TRUE(restored.load(path));
+    EXPECT_EQ(restored.size(Difficulty::Easy), 1u);
+    EXPECT_EQ(restored.size(Difficulty::Medium), 0u);
+    EXPECT_EQ(restored.size(Difficulty::Hard), 2u);
+
+    PuzzlePool::Puzzle taken;
+    ASSERT_TRUE(restored.tryTake(Difficulty::Easy, taken));
+    EXPECT_EQ(taken.givens, easy.givens);
+    EXPECT_EQ(taken.solution, easy.solution);
+
+    EXPECT_FALSE(restored.load(tempPath("missing_pool.bin")));
+    std::remove(path.c_str());
+}
+
+TEST(PuzzlePoolTest, UseArchive_DealsPuzzlesFromTheArchive) {
+    const std::string path = tempPath("pool_source.sar");
+    PuzzlePool::Puzzle easy = PuzzlePool::generate(Difficulty::Easy);
+    const std::vector<PuzzleArchive::Entry> entries = {{Difficulty::Easy, easy.givens, easy.solution}};
+    ASSERT_TRUE(PuzzleArchive::write(path, entries, false));    // no solutions: the pool solves it
+
+    PuzzlePool pool({1, 2});
+    ASSERT_TRUE(pool.useArchive(path));
+    SudokuBoard board;
+    pool.take(Difficulty::Easy, board);
+    EXPECT_TRUE(board.hasConsistentSolution());
+    for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+        EXPECT_EQ(board.getBoard()[cell], easy.givens[cell]);
+    }
+
+    // the refill thread draws from the archive too; Hard is missing there and is generated
+    pool.start();
+    ASSERT_TRUE(waitForStock(pool, 2));
+    pool.stop();
+    PuzzlePool::Puzzle taken;
+    ASSERT_TRUE(pool.tryTake(Difficulty::Easy, taken));
+    EXPECT_EQ(taken.givens, easy.givens);
+    EXPECT_EQ(taken.solution, easy.solution);
+    EXPECT_FALSE(pool.useArchive(tempPath("missing_source.sar")));
+    std::remove(path.c_str());
+}
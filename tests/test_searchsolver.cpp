@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "SearchSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <pthread.h>
+#include <random>
+#include <string>
+
+namespace {
+
+// "AI Escargot", a well-known hard puzzle with a unique solution
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+// puzzles produced by generatePuzzle(Easy), frozen so the test is repeatable
+const std::string GENERATED_EASY_PUZZLES[] = {
+    "2.9.1.784.6.8..9.13.14..625..46..2..61.5.8..3...2..8..1.......957..2314.9481.53..",
+    ".27...4.36.38721.5.9.46.7..4.8791.2.9.12..57.7..5.89.1.76.8..5.21.....3......4..7",
+    ".2.76..141945....3..694...8..5697..1..7.....23..2847...51.3..8.47.8.2.69...179.3.",
+    "..9.1...81.85..79...47.81.5327951.84..68..9..98.26....5.3..9..18.1673.....218....",
+    "123..958...6215.79.9..48.1...2196457..1.528..9..7...2661.5.7...2..9........8..9.5",
+    ".8...7.13..31..5..61.3.9.7....6...8.56.97.241794.183.6837.2.......7....59.68.41.7",
+};
+
+SudokuBoard::Grid parseGrid(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        grid[i] = (text[i] >= '1' && text[i] <= '9') ? static_cast<std::uint8_t>(text[i] - '0') : 0;
+    }
+    return grid;
+}
+
+SudokuBoard boardFromGrid(const SudokuBoard::Grid& grid) {
+    SudokuBoard board;
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        if (grid[i] != 0) {
+            board.setCell(i / SudokuBoard::SIZE, i % SudokuBoard::SIZE, grid[i]);
+            board.setPreFilled(i / SudokuBoard::SIZE, i % SudokuBoard::SIZE, true);
+        }
+    }
+    return board;
+}
+
+} // namespace
+
+TEST(SearchSolverTest, Solve_HardPuzzleKeepsGivensAndIsValid) {
+    SudokuBoard::Grid puzzle = parseGrid(HARD_PUZZLE);
+    SudokuBoard::Grid grid = puzzle;
+    SearchSolver solver;
+    ASSERT_TRUE(solver.solve(grid)) << "Hard puzzle should be solvable";
+
+    SudokuBoard board = boardFromGrid(grid);
+    EXPECT_TRUE(board.isFull());
+    EXPECT_TRUE(board.isValid());
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        if (puzzle[i] != 0) {
+            EXPECT_EQ(grid[i], puzzle[i]) << "Given at index " << i << " must not change";
+        }
+    }
+    EXPECT_GT(solver.getStats().nodes, 0u);
+    EXPECT_GT(solver.getStats().forced, 0u) << "Forced cells should be filled without branching";
+}
+
+TEST(SearchSolverTest, Solve_RejectsConflictingGivens) {
+    SudokuBoard::Grid grid{};
+    grid[0] = 5;
+    grid[8] = 5;    // duplicate 5 in row 0
+    SudokuBoard::Grid before = grid;
+    SearchSolver solver;
+    EXPECT_FALSE(solver.solve(grid));
+    EXPECT_EQ(grid, before) << "Failed solve must leave the grid untouched";
+}
+
+TEST(SearchSolverTest, Solve_EmptyGridWithRngFillsBoard) {
+    std::mt19937 rng(42);
+    SudokuBoard::Grid grid{};
+    SearchSolver solver;
+    ASSERT_TRUE(solver.solve(grid, &rng));
+    SudokuBoard board = boardFromGrid(grid);
+    EXPECT_TRUE(board.isFull());
+    EXPECT_TRUE(board.isValid());
+}
+
+TEST(SearchSolverTest, MinRemaining_VisitsFewerNodesThanBacktracking) {
+    std::mt19937 rng(7);
+    SudokuBoard mrv = boardFromGrid(parseGrid(HARD_PUZZLE));
+    SudokuBoard naive = mrv;
+
+    mrv.setSolverEngine(SudokuBoard::SolverEngine::MinRemaining);
+    naive.setSolverEngine(SudokuBoard::SolverEngine::Backtracking);
+    ASSERT_TRUE(mrv.solveBoard(rng));
+    ASSERT_TRUE(naive.solveBoard(rng));
+
+    for (int row = 0; row < SudokuBoard::SIZE; ++row) {
+        for (int col = 0; col < SudokuBoard::SIZE; ++col) {
+            EXPECT_EQ(mrv.getCell(row, col), naive.getCell(row, col)) << "Unique puzzle, engines must agree";
+        }
+    }
+    EXPECT_LT(mrv.getSolveStats().nodes, naive.getSolveStats().nodes);
+    EXPECT_LT(mrv.getSolveStats().backtracks, naive.getSolveStats().backtracks);
+}
+
+TEST(SearchSolverTest, Propagation_SolvesEasyPuzzlesWithoutBacktracking) {
+    SudokuBoard::Grid grid = parseGrid(EASY_PUZZLE);
+    SearchSolver solver;
+    ASSERT_TRUE(solver.solve(grid));
+    EXPECT_EQ(solver.getStats().backtracks, 0u) << "Singles and locked candidates should crack Easy puzzles";
+    EXPECT_EQ(solver.getStats().nodes, 1u);
+
+    for (const std::string& puzzle : GENERATED_EASY_PUZZLES) {
+        grid = parseGrid(puzzle);
+        ASSERT_TRUE(solver.solve(grid)) << puzzle;
+        EXPECT_EQ(solver.getStats().backtracks, 0u) << puzzle;
+        EXPECT_EQ(solver.getStats().nodes, 1u) << puzzle;
+    }
+}
+
+TEST(SearchSolverTest, Propagation_ReportsPerRuleCounts) {
+    SudokuBoard::Grid grid = parseGrid(HARD_PUZZLE);
+    SearchSolver solver;
+    ASSERT_TRUE(solver.solve(grid));
+    const auto& stats = solver.getStats();
+    EXPECT_GT(stats.naked_singles + stats.hidden_singles, 0u);
+    EXPECT_EQ(stats.forced, stats.naked_singles + stats.hidden_singles);
+    EXPECT_GT(stats.pointing_eliminations + stats.claiming_eliminations, 0u)
+        << "A hard puzzle should need locked-candidate eliminations";
+}
+
+TEST(SearchSolverTest, Search_FitsOnASmallThreadStack) {
+    // a 25x25 fill goes hundreds of levels deep; neither the levels nor the solver the board
+    // builds for solveBoard and countSolutions may put a large state or trail on the stack
+    using BigBoard = BasicSudokuBoard<5, 5>;
+    struct Job {
+        bool solved = false;
+        int solutions = 0;
+        bool full = false;
+        bool valid = false;
+    } job;
+    pthread_attr_t attr;
+    ASSERT_EQ(pthread_attr_init(&attr), 0);
+    ASSERT_EQ(pthread_attr_setstacksize(&attr, 256 * 1024), 0);
+    pthread_t thread;
+    ASSERT_EQ(pthread_create(&thread, &attr, [](void* arg) -> void* {
+        auto* job = static_cast<Job*>(arg);
+        BigBoard board;
+        board.setSolverEngine(BigBoard::SolverEngine::MinRemaining);
+        std::mt19937 rng(9);
+        job->solutions = board.countSolutions(2);
+        job->solved = board.solveBoard(rng);
+        job->full = board.isFull();
+        job->valid = board.isValid();
+        return nullptr;
+    }, &job), 0);
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attr);
+
+    EXPECT_EQ(job.solutions, 2);
+    EXPECT_TRUE(job.solved);
+    EXPECT_TRUE(job.full);
+    EXPECT_TRUE(job.valid);
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "SolveCommand.hpp"
+#include "PuzzleArchive.hpp"
+#include "SearchSolver.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+
+std::string solutionText(const std::string& puzzle) {
+    SudokuBoard::Grid grid{};
+    SearchSolver solver;
+    EXPECT_TRUE(PuzzleCorpus::parseText(puzzle, grid) && solver.solve(grid));
+    std::string text;
+    for (std::uint8_t value : grid) {
+        text.push_back(static_cast<char>('0' + value));
+    }
+    return text;
+}
+
+} // namespace
+
+TEST(SolveCommandTest, Run_WritesResultsInInputOrder) {
+    std::string unsolvable = HARD_PUZZLE;
+    unsolvable[1] = '1';    // duplicates the 1 in the first cell
+
+    // enough lines that every thread gets a chunk
+    std::ostringstream input;
+    std::ostringstream expected;
+    for (int i = 0; i < 300; ++i) {
+        const std::string& puzzle = i % 2 ? EASY_PUZZLE : HARD_PUZZLE;
+        input << puzzle << "\n";
+        expected << solutionText(puzzle) << "\n";
+    }
+    input << "\n" << unsolvable << "\n" << "123";
+    expected << unsolvable << " unsolvable\n" << "123 invalid\n";
+
+    std::istringstream in(input.str());
+    std::ostringstream out;
+    SolveCommand command({"-", 4});
+    auto streamed = command.run(in, out);
+    ASSERT_TRUE(streamed);
+    SolveCommand::Report report = *streamed;
+
+    EXPECT_EQ(out.str(), expected.str());
+    EXPECT_EQ(report.puzzles, 302u);
+    EXPECT_EQ(report.solved, 300u);
+    EXPECT_EQ(report.unsolvable, 1u);
+    EXPECT_EQ(report.invalid, 1u);
+    EXPECT_LE(report.p50_us, report.p99_us);
+    EXPECT_LE(report.p99_us, report.max_us);
+}
+
+TEST(SolveCommandTest, RunFile_MappedTextAndPackedMatchStreamedOutput) {
+    const std::string text_path = ::testing::TempDir() + "solve_input.txt";
+    const std::string packed_path = ::testing::TempDir() + "solve_input.bin";
+    std::ostringstream input;
+    {
+        std::ofstream packed(packed_path, std::ios::binary);
+        PuzzleCorpus::writePackedHeader(packed);
+        for (int i = 0; i < 200; ++i) {
+            const std::string& puzzle = i % 3 ? EASY_PUZZLE : HARD_PUZZLE;
+            input << puzzle << "\n";
+            SudokuBoard::Grid grid{};
+            ASSERT_TRUE(PuzzleCorpus::parseText(puzzle, grid));
+            std::uint8_t record[PuzzleCorpus::PACKED_RECORD_SIZE];
+            PuzzleCorpus::pack(grid, record);
+            packed.write(reinterpret_cast<const char*>(record), sizeof(record));
+        }
+        std::ofstream text(text_path);
+        text << input.str();
+    }
+
+    SolveCommand command({"-", 3});
+    std::istringstream in(input.str());
+    std::ostringstream streamed;
+    ASSERT_TRUE(command.run(in, streamed));
+
+    std::ostringstream mapped_text;
+    auto text_report = command.runFile(text_path, mapped_text);
+    ASSERT_TRUE(text_report);
+    EXPECT_EQ(text_report->solved, 200u);
+    EXPECT_EQ(mapped_text.str(), streamed.str());
+
+    std::ostringstream mapped_packed;
+    auto packed_report = command.runFile(packed_path, mapped_packed);
+    ASSERT_TRUE(packed_report);
+    EXPECT_EQ(mapped_packed.str(), streamed.str());
+
+    std::remove(text_path.c_str());
+    std::remove(packed_path.c_str());
+}
+
+TEST(SolveCommandTest, Run_RejectsAPackedHeaderOfAnotherVersion) {
+    std::string header(PuzzleCorpus::PACKED_HEADER_SIZE, '\0');
+    std::copy(std::begin(PuzzleCorpus::PACKED_MAGIC), std::end(PuzzleCorpus::PACKED_MAGIC), header.begin());
+    header[8] = 9;                          // version 9, little-endian
+    header[12] = static_cast<char>(PuzzleCorpus::PACKED_RECORD_SIZE);
+
+    std::istringstream in(header + std::string(PuzzleCorpus::PACKED_RECORD_SIZE, '\0'));
+    std::ostringstream out;
+    SolveCommand command({"-", 2});
+    EXPECT_FALSE(command.run(in, out).has_value()) << "A stream must fail like the same file would";
+    EXPECT_TRUE(out.str().empty());
+
+    const std::string path = ::testing::TempDir() + "solve_version9.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << header;
+    }
+    EXPECT_FALSE(command.runFile(path, out).has_value());
+    std::remove(path.c_str());
+}
+
+TEST(SolveCommandTest, Validate_ReportsUniqueness) {
+    std::string loose = HARD_PUZZLE;
+    loose[0] = '.';
+    loose[6] = '.';
+    std::istringstream in(HARD_PUZZLE + "\n" + loose + "\n");
+    std::ostringstream out;
+    SolveCommand command({"-", 2, SolveCommand::Mode::Validate});
+    SolveCommand::Report report = command.run(in, out).value();
+    EXPECT_EQ(out.str(), HARD_PUZZLE + " unique\n" + loose + " multiple\n");
+    EXPECT_EQ(report.solved, 1u);
+    EXPECT_EQ(report.multiple, 1u);
+}
+
+TEST(SolveCommandTest, PackArchive_IsReadByTheBatchModes) {
+    const std::string text_path = ::testing::TempDir() + "pack_input.txt";
+    const std::string archive_path = ::testing::TempDir() + "pack_output.sar";
+    {
+        std::ofstream text(text_path);
+        for (int i = 0; i < 30; ++i) text << (i % 3 ? EASY_PUZZLE : HARD_PUZZLE) << "\n";
+        text << "not a puzzle\n";
+    }
+    std::string args[] = {"pack", text_path, archive_path, "--solutions"};
+    char* argv[] = {args[0].data(), args[1].data(), args[2].data(), args[3].data()};
+    ASSERT_EQ(SolveCommand::main(4, argv), 0);
+
+    PuzzleArchive archive;
+    ASSERT_TRUE(archive.open(archive_path));
+    EXPECT_TRUE(archive.hasSolutions());
+    EXPECT_EQ(archive.size(), 30u);
+    EXPECT_EQ(archive.size(SudokuBoard::Difficulty::Hard), 10u);    // the hard puzzle needs guessing
+
+    // solve groups by difficulty, so only the totals match the text input
+    std::ostringstream out;
+    SolveCommand command({"-", 2});
+    auto report = command.runFile(archive_path, out);
+    ASSERT_TRUE(report);
+    EXPECT_EQ(report->solved, 30u);
+    EXPECT_NE(out.str().find(solutionText(HARD_PUZZLE)), std::string::npos);
+
+    std::remove(text_path.c_str());
+    std::remove(archive_path.c_str());
+}
+
+TEST(SolveCommandTest, Main_RejectsUnknownFlagsInsteadOfReadingThemAsFiles) {
+    auto exitCode = [](std::vector<std::string> args) {
+        std::vector<char*> argv;
+        for (auto& arg : args) argv.push_back(arg.data());
+        return SolveCommand::main(static_cast<int>(argv.size()), argv.data());
+    };
+    EXPECT_EQ(exitCode({"solve", "--thread", "4"}), 2);
+    EXPECT_EQ(exitCode({"solve", "-j"}), 2) << "-j without a value";
+    EXPECT_EQ(exitCode({"validate", "a.txt", "b.txt"}), 2);
+    EXPECT_EQ(exitCode({"pack", "--solution", "out.sar"}), 2);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "SearchSolver.hpp"
+#include "StepSolver.hpp"
+#include "SudokuBoard.hpp"
+#include <random>
+#include <string>
+
+namespace {
+
+const std::string HARD_PUZZLE =
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..";
+const std::string EASY_PUZZLE =
+    "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+
+SudokuBoard::Grid parseGrid(const std::string& text) {
+    SudokuBoard::Grid grid{};
+    for (int i = 0; i < SudokuBoard::CELLS; ++i) {
+        grid[i] = (text[i] >= '1' && text[i] <= '9') ? static_cast<std::uint8_t>(text[i] - '0') : 0;
+    }
+    return grid;
+}
+
+} // namespace
+
+TEST(StepSolverTest, SingleSteps_MatchOneSearchSolverCall) {
+    for (const auto& text : {HARD_PUZZLE, EASY_PUZZLE, std::string(81, '.')}) {
+        const SudokuBoard::Grid puzzle = parseGrid(text);
+        SudokuBoard::Grid expected = puzzle;
+        std::mt19937 search_rng(11);
+        SearchSolver search;
+        ASSERT_TRUE(search.solve(expected, &search_rng));
+
+        std::mt19937 step_rng(11);
+        StepSolver stepper;
+        ASSERT_TRUE(stepper.start(puzzle, &step_rng));
+        std::uint64_t calls = 0;
+        while (stepper.step(1) == StepSolver::Status::Running) {
+            ++calls;
+            EXPECT_EQ(stepper.getStats().nodes, calls) << "one node per step";
+        }
+        ASSERT_EQ(stepper.getStatus(), StepSolver::Status::Solved);
+        EXPECT_EQ(stepper.getSolution(), expected);
+        EXPECT_EQ(stepper.getStats().nodes, search.getStats().nodes);
+        EXPECT_EQ(stepper.getStats().backtracks, search.getStats().backtracks);
+        EXPECT_EQ(stepper.getStats().forced, search.getStats().forced);
+    }
+}
+
+TEST(StepSolverTest, Step_PausesAndResumesWithTheSearchIntact) {
+    StepSolver stepper;
+    ASSERT_TRUE(stepper.start(parseGrid(HARD_PUZZLE)));
+    EXPECT_EQ(stepper.step(3), StepSolver::Status::Running);
+    EXPECT_EQ(stepper.getStats().nodes, 3u);
+    EXPECT_GT(stepper.getDepth(), 0u) << "The hard puzzle needs guesses, so branch points are open";
+    EXPECT_EQ(stepper.step(0), StepSolver::Status::Running);
+    EXPECT_EQ(stepper.getStats().nodes, 3u) << "A zero budget visits nothing";
+
+    EXPECT_EQ(stepper.run(), StepSolver::Status::Solved);
+    EXPECT_EQ(stepper.getDepth(), 0u);
+    EXPECT_EQ(stepper.step(5), StepSolver::Status::Solved) << "Stepping a finished search is a no-op";
+
+    stepper.reset();
+    EXPECT_EQ(stepper.getStatus(), StepSolver::Status::Idle);
+    EXPECT_EQ(stepper.step(5), StepSolver::Status::Idle);
+}
+
+TEST(StepSolverTest, Limit_CountsSolutionsLikeSearchSolver) {
+    SearchSolver search;
+    StepSolver stepper;
+    SudokuBoard::Grid unique = parseGrid(HARD_PUZZLE);
+    ASSERT_TRUE(stepper.start(unique, nullptr, 2));
+    EXPECT_EQ(stepper.run(), StepSolver::Status::Solved);
+    EXPECT_EQ(stepper.getSolutionCount(), 1);
+
+    SudokuBoard::Grid open = unique;
+    open[0] = 0;
+    open[5] = 0;
+    open[7] = 0;
+    ASSERT_TRUE(stepper.start(open, nullptr, 5));
+    EXPECT_EQ(stepper.run(), StepSolver::Status::Solved);
+    EXPECT_EQ(stepper.getSolutionCount(), search.countSolutions(open, 5));
+    EXPECT_GT(stepper.getSolutionCount(), 1);
+}
+
+TEST(StepSolverTest, Start_ReportsConflictsAndDeadEnds) {
+    StepSolver stepper;
+    SudokuBoard::Grid grid{};
+    grid[0] = 5;
+    grid[8] = 5;    // duplicate 5 in row 0
+    EXPECT_FALSE(stepper.start(grid));
+    EXPECT_EQ(stepper.getStatus(), StepSolver::Status::Unsolvable);
+
+    // no conflict among the givens, but the top-left cell has no digit left
+    grid = {};
+    for (int col = 1; col < 9; ++col) grid[col] = static_cast<std::uint8_t>(col);
+    grid[9 * 4] = 9;
+    ASSERT_TRUE(stepper.start(grid));
+    EXPECT_EQ(stepper.run(), StepSolver::Status::Unsolvable);
+    EXPECT_EQ(stepper.getSolutionCount(), 0);
+}
+
+TEST(StepSolverTest, LargeGrid_SolvesInBoundedSlices) {
+    using Board16 = BasicSudokuBoard<4, 4>;
+    using Status16 = BasicStepSolver<4, 4>::Status;
+    BasicStepSolver<4, 4> stepper;
+    std::mt19937 rng(5);
+    ASSERT_TRUE(stepper.start(Board16::Grid{}, &rng));
+    int slices = 0;
+    while (stepper.step(8) == Status16::Running) {
+        ++slices;
+        EXPECT_LE(stepper.getDepth(), static_cast<std::size_t>(Board16::CELLS));
+    }
+    ASSERT_EQ(stepper.getStatus(), Status16::Solved);
+    EXPECT_GT(slices, 0);
+
+    Board16 board;
+    for (int cell = 0; cell < Board16::CELLS; ++cell) {
+        board.setCell(cell / Board16::SIZE, cell % Board16::SIZE, stepper.getSolution()[cell]);
+    }
+    EXPECT_TRUE(board.isFull());
+    EXPECT_TRUE(board.isValid());
+}
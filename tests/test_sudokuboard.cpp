@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "SudokuBoard.hpp"
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 // Test fixture for SudokuBoard
 class SudokuBoardTest : public ::testing::Test {
@@ -181,6 +183,137 @@ TEST_F(SudokuBoardTest, GetHint_CorrectBehavior) {
     EXPECT_FALSE(board.getHint(0, 4, rng).has_value()) << "Exceeding max hints should return nullopt";
 }
 
+TEST_F(SudokuBoardTest, GetHint_UsesStoredSolutionUntilContradicted) {
+    std::mt19937 rng(7);
+    board.generatePuzzle(SudokuBoard::Difficulty::Hard);
+    ASSERT_TRUE(board.hasConsistentSolution()) << "Generated puzzle should carry its solution";
+
+    SudokuBoard solved = board;
+    ASSERT_TRUE(solved.solveBoard(rng));
+
+    // find two empty cells: one to answer, one to get wrong
+    std::vector<std::pair<int, int>> empty;
+    for (int row = 0; row < SudokuBoard::SIZE; ++row) {
+        for (int col = 0; col < SudokuBoard::SIZE; ++col) {
+            if (board.getCell(row, col) == 0) empty.emplace_back(row, col);
+        }
+    }
+    ASSERT_GE(empty.size(), 2u);
+    auto [hint_row, hint_col] = empty[0];
+    auto [wrong_row, wrong_col] = empty[1];
+
+    auto hint = board.getHint(hint_row, hint_col, rng);
+    ASSERT_TRUE(hint.has_value());
+    EXPECT_EQ(*hint, solved.getCell(hint_row, hint_col)) << "Unique puzzle has one correct hint";
+
+    // a wrong digit invalidates the stored answer; undo restores it
+    int wrong = solved.getCell(wrong_row, wrong_col) % SudokuBoard::SIZE + 1;
+    ASSERT_TRUE(board.setCell(wrong_row, wrong_col, wrong));
+    EXPECT_FALSE(board.hasConsistentSolution());
+    ASSERT_TRUE(board.undo());
+    EXPECT_TRUE(board.hasConsistentSolution());
+
+    // correct entries keep it
+    ASSERT_TRUE(board.setCell(wrong_row, wrong_col, solved.getCell(wrong_row, wrong_col)));
+    EXPECT_TRUE(board.hasConsistentSolution());
+
+    board.clear();
+    EXPECT_FALSE(board.hasConsistentSolution()) << "Clear should forget the solution";
+}
+
+TEST_F(SudokuBoardTest, GetHint_AnswersACellHoldingAWrongDigit) {
+    // the classic puzzle, loaded without its answer key; its solution starts 534678912
+    const char* text = "530070000600195000098000060800060003400803001700020006060000280000419005000080079";
+    SudokuBoard::Grid puzzle{};
+    for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+        puzzle[cell] = static_cast<std::uint8_t>(text[cell] - '0');
+    }
+    std::mt19937 rng(5);
+    ASSERT_TRUE(board.loadPuzzle(puzzle));
+    ASSERT_TRUE(board.setCell(0, 2, 1));
+    auto hint = board.getHint(0, 2, rng);
+    ASSERT_TRUE(hint.has_value()) << "The wrong digit being asked about must not block the hint";
+    EXPECT_EQ(*hint, 4);
+
+    // a second wrong entry elsewhere: the hint falls back to the givens
+    ASSERT_TRUE(board.loadPuzzle(puzzle));
+    ASSERT_TRUE(board.setCell(0, 2, 1));
+    ASSERT_TRUE(board.setCell(0, 3, 2));
+    hint = board.getHint(0, 2, rng);
+    ASSERT_TRUE(hint.has_value());
+    EXPECT_EQ(*hint, 4);
+}
+
+TEST_F(SudokuBoardTest, GetHint_KeepsTheAnswerKeyThroughPlayerMistakes) {
+    std::mt19937 rng(13);
+    board.generatePuzzle(SudokuBoard::Difficulty::Easy);
+    auto key = board.getSolution();
+    ASSERT_TRUE(key.has_value());
+    SudokuBoard::Grid answer{};
+    std::copy(key->begin(), key->end(), answer.begin());
+
+    std::vector<int> empty;
+    for (int cell = 0; cell < SudokuBoard::CELLS; ++cell) {
+        if (board.getBoard()[cell] == 0) empty.push_back(cell);
+    }
+    ASSERT_GE(empty.size(), 2u);
+    const int wrong_cell = empty[0];
+    const int hint_cell = empty[1];
+    const int row = wrong_cell / SudokuBoard::SIZE;
+    const int col = wrong_cell % SudokuBoard::SIZE;
+    ASSERT_TRUE(board.setCell(row, col, answer[wrong_cell] % SudokuBoard::SIZE + 1));
+    EXPECT_FALSE(board.hasConsistentSolution());
+    EXPECT_TRUE(board.hasAnswerKey()) << "A player's mistake cannot change a unique puzzle's answer";
+
+    auto hint = board.getHint(hint_cell / SudokuBoard::SIZE, hint_cell % SudokuBoard::SIZE, rng);
+    ASSERT_TRUE(hint.has_value());
+    EXPECT_EQ(*hint, answer[hint_cell]);
+    hint = board.getHint(row, col, rng);
+    ASSERT_TRUE(hint.has_value());
+    EXPECT_EQ(*hint, answer[wrong_cell]);
+
+    // only changed givens retire the key
+    board.setPreFilled(row, col, true);
+    EXPECT_FALSE(board.hasAnswerKey());
+    board.setPreFilled(row, col, false);
+    EXPECT_TRUE(board.hasAnswerKey());
+}
+
+TEST_F(SudokuBoardTest, AdoptSolution_AcceptsOnlyAnswersThatFitTheGivens) {
+    std::mt19937 rng(3);
+    SudokuBoard solved;
+    ASSERT_TRUE(solved.solveBoard(rng));
+    SudokuBoard::Grid answer{};
+    std::copy(solved.getBoard().begin(), solved.getBoard().end(), answer.begin());
+
+    ASSERT_TRUE(board.setCell(0, 0, answer[0]));
+    board.setPreFilled(0, 0, true);
+    SudokuBoard::Grid partial = answer;
+    partial[80] = 0;
+    EXPECT_FALSE(board.adoptSolution(partial)) << "An incomplete grid is no answer key";
+    SudokuBoard::Grid other = answer;
+    other[0] = static_cast<std::uint8_t>(answer[0] % SudokuBoard::SIZE + 1);
+    EXPECT_FALSE(board.adoptSolution(other)) << "It must keep the givens";
+    EXPECT_FALSE(board.hasConsistentSolution());
+    EXPECT_FALSE(board.getSolution().has_value());
+
+    ASSERT_TRUE(board.adoptSolution(answer));
+    EXPECT_TRUE(board.hasConsistentSolution());
+    auto key = board.getSolution();
+    ASSERT_TRUE(key.has_value());
+    EXPECT_TRUE(std::equal(key->begin(), key->end(), answer.begin()));
+    auto hint = board.getHint(4, 4, rng);
+    ASSERT_TRUE(hint.has_value());
+    EXPECT_EQ(*hint, answer[4 * SudokuBoard::SIZE + 4]) << "The hint comes from the adopted answer";
+
+    // a player's wrong entry does not stand in the way of a key that fits the givens
+    board.clear();
+    ASSERT_TRUE(board.setCell(0, 1, answer[1] % SudokuBoard::SIZE + 1));
+    EXPECT_TRUE(board.adoptSolution(answer));
+    EXPECT_TRUE(board.hasAnswerKey());
+    EXPECT_FALSE(board.hasConsistentSolution());
+}
+
 TEST_F(SudokuBoardTest, RemoveCells_ProducesSolvablePuzzle) {
     std::random_device rd;
     std::mt19937 rng(rd());
@@ -204,6 +337,7 @@ TEST_F(SudokuBoardTest, RemoveCells_ProducesSolvablePuzzle) {
     EXPECT_TRUE(board.isValid()) << "Board should be valid after removal";
     SudokuBoard temp = board;
     EXPECT_TRUE(temp.solveBoard(rng)) << "Board should be solvable after removal";
+    EXPECT_EQ(board.countSolutions(2), 1) << "Removal should keep the solution unique";
 }
 
 TEST_F(SudokuBoardTest, GeneratePuzzle_ProducesValidPuzzle) {
@@ -227,6 +361,7 @@ TEST_F(SudokuBoardTest, GeneratePuzzle_ProducesValidPuzzle) {
     EXPECT_TRUE(board.isValid()) << "Easy puzzle should be valid";
     SudokuBoard temp_easy = board;
     EXPECT_TRUE(temp_easy.solveBoard(rng)) << "Easy puzzle should be solvable";
+    EXPECT_EQ(board.countSolutions(2), 1) << "Easy puzzle should have a unique solution";
     EXPECT_EQ(board.getHintsUsed(), 0) << "New puzzle should reset hints";
 
     // Test Medium (25 cells)
@@ -246,6 +381,7 @@ TEST_F(SudokuBoardTest, GeneratePuzzle_ProducesValidPuzzle) {
     EXPECT_TRUE(board.isValid()) << "Medium puzzle should be valid";
     SudokuBoard temp_medium = board;
     EXPECT_TRUE(temp_medium.solveBoard(rng)) << "Medium puzzle should be solvable";
+    EXPECT_EQ(board.countSolutions(2), 1) << "Medium puzzle should have a unique solution";
 
     // Test Hard (15 cells)
     board.generatePuzzle(SudokuBoard::Difficulty::Hard);
@@ -260,8 +396,10 @@ TEST_F(SudokuBoardTest, GeneratePuzzle_ProducesValidPuzzle) {
             }
         }
     }
-    EXPECT_EQ(filled, 15) << "Hard puzzle should have 15 filled cells";
+    EXPECT_GE(filled, 17) << "No unique puzzle has fewer than 17 clues";
+    EXPECT_LT(filled, 25) << "Hard puzzle should be sparser than Medium";
     EXPECT_TRUE(board.isValid()) << "Hard puzzle should be valid";
+    EXPECT_EQ(board.countSolutions(2), 1) << "Hard puzzle should have a unique solution";
     SudokuBoard temp_hard = board;
     EXPECT_TRUE(temp_hard.solveBoard(rng)) << "Hard puzzle should be solvable";
 }
@@ -272,20 +410,12 @@ TEST_F(SudokuBoardTest, GeneratePuzzle_Randomization) {
 
     // Generate two Easy puzzles
     board.generatePuzzle(SudokuBoard::Difficulty::Easy);
-    std::vector<std::vector<int>> board1 = board.getBoard(); 
+    const SudokuBoard board1 = board;   // snapshot copy, getBoard() is only a view
     board.generatePuzzle(SudokuBoard::Difficulty::Easy);
-    std::vector<std::vector<int>> board2 = board.getBoard(); 
     // Check if boards differ
-    bool different = false;
-    for (int row = 0; row < SudokuBoard::SIZE; ++row) {
-        for (int col = 0; col < SudokuBoard::SIZE; ++col) {
-            if (board1[row][col] != board2[row][col]) {
-                different = true;
-                break;
-            }
-        }
-        if (different) break;
-    }
+    auto view1 = board1.getBoard();
+    auto view2 = board.getBoard();
+    bool different = !std::equal(view1.begin(), view1.end(), view2.begin());
     EXPECT_TRUE(different) << "Two Easy puzzles should differ due to randomization";
 }
 
@@ -316,6 +446,32 @@ TEST_F(SudokuBoardTest, GeneratePuzzle_ResetsPartialBoard) {
     EXPECT_EQ(board.getHintsUsed(), 0) << "Puzzle should reset hints";
 }
 
+TEST_F(SudokuBoardTest, RemovalTarget_HarderLevelsLeaveFewerClues) {
+    using Difficulty = SudokuBoard::Difficulty;
+    EXPECT_EQ(SudokuBoard::CELLS - SudokuBoard::removalTarget(Difficulty::Hard), 24);
+    EXPECT_LT(SudokuBoard::removalTarget(Difficulty::Easy), SudokuBoard::removalTarget(Difficulty::Medium));
+    EXPECT_LT(SudokuBoard::removalTarget(Difficulty::Medium), SudokuBoard::removalTarget(Difficulty::Hard));
+    EXPECT_LT(SudokuBoard4::removalTarget(Difficulty::Medium), SudokuBoard4::removalTarget(Difficulty::Hard))
+        << "Scaled targets must not collapse on small grids";
+}
+
+TEST_F(SudokuBoardTest, GeneratePuzzle_StopsOnceCancelled) {
+    std::mt19937 rng(11);
+    ASSERT_TRUE(board.solveBoard(rng));
+    std::atomic<bool> cancel{true};
+    board.setCancelFlag(&cancel);
+    EXPECT_EQ(board.removeCells(40, rng), 0) << "A set flag stops digging before the first removal";
+    EXPECT_TRUE(board.isFull());
+
+    board.generatePuzzle(SudokuBoard::Difficulty::Hard);
+    EXPECT_EQ(board.getFilledCount(), 0) << "A cancelled generation leaves the board empty";
+    EXPECT_FALSE(board.getSolution().has_value());
+
+    cancel = false;
+    board.generatePuzzle(SudokuBoard::Difficulty::Easy);
+    EXPECT_EQ(board.getFilledCount(), SudokuBoard::CELLS - SudokuBoard::removalTarget(SudokuBoard::Difficulty::Easy));
+}
+
 TEST_F(SudokuBoardTest, Undo_CorrectBehavior) {
     std::random_device rd;
     std::mt19937 rng(rd());
@@ -474,4 +630,219 @@ TEST_F(SudokuBoardTest, FindErrors_IdentifiesAllDuplicates) {
 
     // Check total number of unique error cells
     EXPECT_EQ(error_set.size(), 9);
-}
\ No newline at end of file
+}
+TEST_F(SudokuBoardTest, IsInConflict_TracksEditsAndUndo) {
+    board.setCell(0, 0, 5);
+    board.setCell(0, 4, 5);     // row duplicate
+    board.setCell(2, 2, 5);     // box duplicate of (0,0)
+    EXPECT_TRUE(board.isInConflict(0, 0));
+    EXPECT_TRUE(board.isInConflict(0, 4));
+    EXPECT_TRUE(board.isInConflict(2, 2));
+    EXPECT_FALSE(board.isValid());
+
+    // (0,0) stays in conflict through the box after the row duplicate goes away
+    board.setCell(0, 4, 0);
+    EXPECT_FALSE(board.isInConflict(0, 4));
+    EXPECT_TRUE(board.isInConflict(0, 0));
+    EXPECT_TRUE(board.isInConflict(2, 2));
+
+    board.setCell(2, 2, 7);
+    EXPECT_FALSE(board.isInConflict(0, 0));
+    EXPECT_FALSE(board.isInConflict(2, 2));
+    EXPECT_TRUE(board.isValid());
+    EXPECT_TRUE(board.findErrors().empty());
+
+    ASSERT_TRUE(board.undo());  // (2,2) back to 5
+    EXPECT_TRUE(board.isInConflict(0, 0));
+    EXPECT_TRUE(board.isInConflict(2, 2));
+    EXPECT_EQ(board.findErrors().size(), 2u);
+    EXPECT_FALSE(board.isInConflict(-1, 0));
+
+    board.clear();
+    EXPECT_FALSE(board.isInConflict(0, 0));
+    EXPECT_TRUE(board.isValid());
+}
+
+TEST_F(SudokuBoardTest, Counters_FollowEveryMutationPath) {
+    std::mt19937 rng(11);
+    board.generatePuzzle(SudokuBoard::Difficulty::Medium);
+    int clues = board.getFilledCount();
+    EXPECT_GT(clues, 0);
+    EXPECT_EQ(board.getConflictCount(), 0);
+    EXPECT_FALSE(board.isFull());
+
+    // duplicate a given digit in its own row; a sparse puzzle may leave some rows without clues
+    int row = 0, col = -1, given_value = 0;
+    for (; row < SudokuBoard::SIZE; ++row) {
+        col = -1;
+        given_value = 0;
+        for (int c = 0; c < SudokuBoard::SIZE; ++c) {
+            if (board.getCell(row, c) == 0) {
+                if (col < 0) col = c;
+            } else if (given_value == 0) {
+                given_value = board.getCell(row, c);
+            }
+        }
+        if (col >= 0 && given_value != 0) break;
+    }
+    ASSERT_LT(row, SudokuBoard::SIZE);
+    ASSERT_TRUE(board.setCell(row, col, given_value));
+    EXPECT_EQ(board.getFilledCount(), clues + 1);
+    EXPECT_GE(board.getConflictCount(), 2);
+    EXPECT_FALSE(board.isValid());
+
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(board.getFilledCount(), clues);
+    EXPECT_EQ(board.getConflictCount(), 0);
+
+    ASSERT_TRUE(board.solveBoard(rng));
+    EXPECT_EQ(board.getFilledCount(), SudokuBoard::CELLS);
+    EXPECT_TRUE(board.isFull());
+    EXPECT_TRUE(board.isValid());
+
+    board.clear();
+    EXPECT_EQ(board.getFilledCount(), 0);
+    EXPECT_EQ(board.getConflictCount(), 0);
+}
+
+TEST_F(SudokuBoardTest, GetCandidates_TracksEditsUndoAndClear) {
+    constexpr std::uint16_t ALL = 0x1FF;
+    EXPECT_EQ(board.getCandidates(4, 4), ALL) << "Empty board should allow every digit";
+    EXPECT_EQ(board.countCandidates(4, 4), 9);
+
+    board.setCell(4, 0, 1);     // same row
+    board.setCell(0, 4, 2);     // same column
+    board.setCell(3, 3, 3);     // same box
+    EXPECT_EQ(board.getCandidates(4, 4), ALL & ~0b111) << "Digits 1-3 should be ruled out";
+    EXPECT_EQ(board.countCandidates(4, 4), 6);
+    EXPECT_EQ(board.getCandidates(4, 0), 0) << "Filled cell should have no candidates";
+
+    // duplicate 1 in row 4, removing one copy must keep the digit marked as used
+    board.setCell(4, 8, 1);
+    board.setCell(4, 0, 0);
+    EXPECT_FALSE(board.isValidMove(4, 4, 1)) << "Remaining 1 in row 4 should still block";
+    EXPECT_TRUE(board.isValidMove(4, 8, 1)) << "Cell's own digit is valid without a duplicate";
+
+    EXPECT_TRUE(board.undo());
+    EXPECT_FALSE(board.isValidMove(4, 8, 1)) << "Undo restores the duplicate";
+    EXPECT_TRUE(board.undo());
+    EXPECT_FALSE(board.isValidMove(4, 4, 1)) << "1 at (4,0) should still block row 4";
+    EXPECT_TRUE(board.isValidMove(4, 0, 1)) << "Undoing the 1 at (4,8) clears the duplicate";
+    board.clear();
+    EXPECT_EQ(board.getCandidates(4, 4), ALL) << "Clear should reset all masks";
+}
+
+TEST_F(SudokuBoardTest, GetBoard_IsFlatRowMajorView) {
+    board.setCell(0, 0, 7);
+    board.setCell(2, 5, 3);
+    auto view = board.getBoard();
+    ASSERT_EQ(view.size(), static_cast<size_t>(SudokuBoard::CELLS));
+    EXPECT_EQ(view[0], 7);
+    EXPECT_EQ(view[2 * SudokuBoard::SIZE + 5], 3);
+
+    // copies are independent snapshots
+    SudokuBoard snapshot = board;
+    board.setCell(0, 0, 1);
+    EXPECT_EQ(snapshot.getCell(0, 0), 7);
+    EXPECT_TRUE(snapshot.canUndo()) << "Undo ring is part of the snapshot";
+    EXPECT_TRUE(snapshot.undo());
+    EXPECT_EQ(snapshot.getCell(2, 5), 0);
+    EXPECT_EQ(board.getCell(2, 5), 3);
+}
+
+TEST_F(SudokuBoardTest, CountSolutions_StopsAtLimit) {
+    EXPECT_EQ(board.countSolutions(2), 2) << "Empty board has many solutions, count is capped";
+    EXPECT_EQ(board.countSolutions(5), 5);
+
+    std::mt19937 rng(1);
+    board.solveBoard(rng);
+    EXPECT_EQ(board.countSolutions(2), 1) << "A full valid board is its own unique solution";
+
+    board.setCell(0, 0, 0);
+    EXPECT_EQ(board.countSolutions(2), 1) << "One hole is always forced";
+
+    board.setCell(0, 0, board.getCell(0, 1));   // duplicate of (0,1) in row 0
+    EXPECT_EQ(board.countSolutions(2), 0) << "Conflicting grid has no solution";
+
+    for (auto engine : {SudokuBoard::SolverEngine::MinRemaining, SudokuBoard::SolverEngine::DancingLinks}) {
+        SudokuBoard empty;
+        empty.setSolverEngine(engine);
+        EXPECT_EQ(empty.countSolutions(2), 2);
+    }
+}
+
+TEST(BasicSudokuBoardTest, SmallAndLargeGeometries_SolveAndValidate) {
+    static_assert(SudokuBoard4::SIZE == 4 && SudokuBoard16::SIZE == 16 && SudokuBoard25::SIZE == 25);
+    static_assert(sizeof(SudokuBoard25::DigitMask) == 4, "25 digits need a 32-bit mask");
+
+    std::mt19937 rng(5);
+    SudokuBoard16 board16;
+    ASSERT_TRUE(board16.solveBoard(rng));
+    EXPECT_TRUE(board16.isFull());
+    EXPECT_TRUE(board16.isValid());
+    EXPECT_TRUE(board16.findErrors().empty());
+
+    SudokuBoard25 board25;
+    ASSERT_TRUE(board25.solveBoard(rng));
+    EXPECT_TRUE(board25.isFull());
+    EXPECT_TRUE(board25.isValid());
+
+    // a duplicate inside a 5x5 box but in a different row and column
+    int value = board25.getCell(0, 0);
+    EXPECT_FALSE(board25.isValidMove(4, 4, value));
+    EXPECT_TRUE(board25.setCell(4, 4, value));
+    EXPECT_FALSE(board25.isValid());
+    auto errors = board25.findErrors();
+    EXPECT_NE(std::find(errors.begin(), errors.end(), std::make_pair(0, 0)), errors.end());
+    EXPECT_NE(std::find(errors.begin(), errors.end(), std::make_pair(4, 4)), errors.end());
+}
+
+TEST(BasicSudokuBoardTest, SmallAndLargeGeometries_GenerateUniquePuzzles) {
+    SudokuBoard4 board4;
+    board4.generatePuzzle(SudokuBoard4::Difficulty::Hard);
+    EXPECT_EQ(board4.countSolutions(), 1);
+    EXPECT_FALSE(board4.setCell(0, 0, 5)) << "Digits stop at SIZE";
+
+    SudokuBoard16 board16;
+    board16.generatePuzzle(SudokuBoard16::Difficulty::Easy);
+    int clues = 0;
+    for (std::uint8_t value : board16.getBoard()) {
+        clues += value != 0;
+    }
+    EXPECT_LE(clues, SudokuBoard16::CELLS - SudokuBoard16::CELLS * 41 / 81 + 8);
+    EXPECT_EQ(board16.countSolutions(), 1);
+}
+
+template <int BoxRows, int BoxCols>
+void expectGeometryMatchesArithmetic() {
+    const auto& geo = SUDOKU_GEOMETRY<BoxRows, BoxCols>;
+    using Geometry = BasicSudokuGeometry<BoxRows, BoxCols>;
+    constexpr int SIZE = Geometry::SIZE;
+    for (int cell = 0; cell < Geometry::CELLS; ++cell) {
+        int row = cell / SIZE;
+        int col = cell % SIZE;
+        int box = (row / BoxRows) * BoxRows + col / BoxCols;
+        EXPECT_EQ(geo.cell_units[cell][0], row);
+        EXPECT_EQ(geo.cell_units[cell][1], SIZE + col);
+        EXPECT_EQ(geo.cell_units[cell][2], 2 * SIZE + box);
+
+        std::vector<int> expected;
+        for (int other = 0; other < Geometry::CELLS; ++other) {
+            int r = other / SIZE;
+            int c = other % SIZE;
+            if (other != cell && (r == row || c == col || (r / BoxRows) * BoxRows + c / BoxCols == box)) {
+                expected.push_back(other);
+            }
+        }
+        std::vector<int> peers(geo.peers[cell].begin(), geo.peers[cell].end());
+        std::sort(peers.begin(), peers.end());
+        EXPECT_EQ(peers, expected) << "cell " << cell;
+    }
+}
+
+TEST(SudokuGeometryTest, TablesMatchRowColumnBoxArithmetic) {
+    static_assert(SudokuGeometry::PEERS == 20);
+    expectGeometryMatchesArithmetic<3, 3>();
+    expectGeometryMatchesArithmetic<2, 2>();
+    expectGeometryMatchesArithmetic<5, 5>();
+}